@@ -6,31 +6,158 @@ It is called when:
 It ensures that the new object gets its own copy of the data.
 */
 #include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <type_traits>
+#ifdef STUDENT_INSTRUMENT
+#include <cstdlib>
+#include <new>
+#endif
 using namespace std;
 
+/*
+Moving :- when the object we copy from is not needed any more (a temporary, or
+an old element while vector grows), copying its name is wasted work: a long
+name means a new heap block plus copying every char. A MOVE constructor takes
+over the name's heap block instead and leaves the old object with an empty
+name. Nothing is allocated.
+
+noexcept matters :- when vector grows it builds the elements again in a new
+block. If moving could throw halfway, the old block would be half emptied and
+could not be given back, so vector only moves when the move constructor is
+marked noexcept. Otherwise it copies every element, every time it grows.
+
+Instrumented build (counts copies, moves and heap allocations while a vector
+grows, and compares with the copy-only Student of the first version):
+    g++ -std=c++17 -DSTUDENT_INSTRUMENT "Copy Constructor.cpp"
+*/
+
+#ifdef STUDENT_INSTRUMENT
+// The names are std::string and the students live in a std::vector: both ask
+// the global operator new, so that is where the blocks are counted. Only while
+// growthReport runs its two loops (countHeap), so cout's own buffers and the
+// small examples in main are left out.
+static size_t heapAllocations = 0;
+static bool countHeap = false;
+void* operator new(size_t bytes) {
+    if (countHeap) heapAllocations++;
+    if (void* p = malloc(bytes ? bytes : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#endif
+
+// how often each special member function ran (always counted, it is cheap)
+struct CopyMoveCounts {
+    size_t copies = 0, moves = 0, copyAssigns = 0, moveAssigns = 0;
+};
+
 class Student {
 public:
     int roll;
     string name;
 
+    static CopyMoveCounts counts;
+    static bool quiet; // true = no "... called!" lines (for loops with many objects)
+
     // Parameterized constructor
-    Student(int r, string n) {
-        roll = r;
-        name = n;
-        cout << "Parameterized Constructor called!" << endl;
+    // n is taken by value and then MOVED into name: a temporary ("Bob", or
+    // a string we do not need any more) is moved twice and never copied, a
+    // named string we keep is copied once (into n) and then moved.
+    Student(int r, string n) : roll(r), name(move(n)) {
+        if (!quiet) cout << "Parameterized Constructor called!" << endl;
     }
 
     // Copy constructor
-    Student(const Student &obj) {
+    Student(const Student &obj) : roll(obj.roll), name(obj.name) {
+        counts.copies++;
+        if (!quiet) cout << "Copy Constructor called!" << endl;
+    }
+
+    // Move constructor: takes the name's memory from obj, obj.name is left empty
+    Student(Student &&obj) noexcept : roll(obj.roll), name(move(obj.name)) {
+        counts.moves++;
+        if (!quiet) cout << "Move Constructor called!" << endl;
+    }
+
+    // Copy assignment (s2 = s1 on an object that already exists)
+    Student& operator=(const Student &obj) {
         roll = obj.roll;
         name = obj.name;
-        cout << "Copy Constructor called!" << endl;
+        counts.copyAssigns++;
+        return *this;
+    }
+
+    // Move assignment (s2 = move(s1), or s2 = a temporary)
+    Student& operator=(Student &&obj) noexcept {
+        roll = obj.roll;
+        name = move(obj.name);
+        counts.moveAssigns++;
+        return *this;
     }
 
     void display() {
         cout << "Roll: " << roll << ", Name: " << name << endl;
     }
 };
+CopyMoveCounts Student::counts;
+bool Student::quiet = false;
+// the promise vector checks before it moves instead of copying
+static_assert(is_nothrow_move_constructible<Student>::value, "vector<Student> would copy when it grows");
+
+#ifdef STUDENT_INSTRUMENT
+// the first version of Student: only a copy constructor, so vector must copy
+class CopyOnlyStudent {
+public:
+    int roll;
+    string name;
+    static size_t copies;
+
+    CopyOnlyStudent(int r, string n) {
+        roll = r;
+        name = n;
+    }
+    CopyOnlyStudent(const CopyOnlyStudent &obj) {
+        roll = obj.roll;
+        name = obj.name;
+        copies++;
+    }
+};
+size_t CopyOnlyStudent::copies = 0;
+
+// push_back n students one by one (no reserve), so the vector grows many times
+void growthReport(size_t n) {
+    Student::quiet = true;
+    const string longName = "A name that is too long for the small string buffer";
+
+    countHeap = true;
+    size_t a0 = heapAllocations;
+    {
+        vector<CopyOnlyStudent> v;
+        for (size_t i = 0; i < n; i++) v.push_back(CopyOnlyStudent((int)i, longName));
+    }
+    size_t a1 = heapAllocations;
+    Student::counts = CopyMoveCounts();
+    {
+        vector<Student> v;
+        for (size_t i = 0; i < n; i++) v.push_back(Student((int)i, longName));
+    }
+    size_t a2 = heapAllocations;
+    countHeap = false;
+
+    cout << "\npush_back of " << n << " students with long names, no reserve:\n";
+    cout << "copy only Student : " << CopyOnlyStudent::copies << " copies, " << a1 - a0
+         << " heap allocations\n";
+    cout << "with noexcept move: " << Student::counts.copies << " copies, " << Student::counts.moves
+         << " moves, " << a2 - a1 << " heap allocations\n";
+    cout << "saved allocations : " << (long long)(a1 - a0) - (long long)(a2 - a1) << "\n";
+    cout << "(" << n << " of the copies / moves put the new student into the vector, the rest\n"
+         << " are the old elements carried over each time the vector grows)\n";
+    Student::quiet = false;
+}
+#endif
 
 int main() {
     Student s1(10, "Bob");   // Calls parameterized constructor
@@ -42,10 +169,17 @@ int main() {
     cout << "\nDisplaying s2 details:" << endl;
     s2.display();
 
+    // s2 is not needed after this line, so its name can be moved out of it
+    Student s3 = move(s2);   // Calls move constructor
+    cout << "\nDisplaying s3 details (moved from s2):" << endl;
+    s3.display();
+
+#ifdef STUDENT_INSTRUMENT
+    growthReport(1000);
+#endif
     return 0;
 }
 
-
 /*
 In main():
 
@@ -68,4 +202,9 @@ obj is a reference to the existing object (s1)
 The statement roll = obj.roll copies the roll number
 The statement name = obj.name copies the name
 
+Student s3 = move(s2);   // Calls move constructor
+
+move(s2) does not move anything by itself, it only says "s2 may be emptied".
+The move constructor then takes s2's name and s2.name becomes empty, so s2
+should not be used after this (only given a new value or destroyed).
 */
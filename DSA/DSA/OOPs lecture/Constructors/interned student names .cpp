@@ -0,0 +1,285 @@
+/*
+Interned names :- keep every different name ONCE and give students a small
+number (a handle) instead of their own string.
+
+In "Copy Constructor.cpp" every Student has its own string name. With millions
+of students there are maybe a few thousand different names, but every copy of
+"Kisuke Urahara, shop owner" is its own heap block (names longer than 15 chars
+do not fit inside the string object). And comparing two names compares chars.
+
+NamePool:
+    intern("Bob")  -> handle 7   (first time: stores "Bob", gives the next number)
+    intern("Bob")  -> handle 7   (already there: same number, nothing stored)
+    text(7)        -> "Bob"      (O(1): the number is an index)
+Two names are equal exactly when their handles are equal, so comparing names is
+comparing two uint32_t.
+
+Many threads can intern at the same time: the lookup table is split into 64
+shards, each with its own lock, so threads only wait for each other when their
+names land in the same shard. Reading text(handle) takes no lock at all.
+
+compile :- g++ -std=c++17 -O2 -pthread "interned student names .cpp"
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+using namespace std;
+
+// The question here is memory footprint, so this adds up the BYTES asked for
+// (not the number of blocks): the long string names, the vectors, and the
+// pool's hash slots, name arenas and entry segments all come through here.
+// Atomic, because several threads intern at once.
+static atomic<size_t> heapBytes{0};
+void* operator new(size_t bytes) {
+    heapBytes.fetch_add(bytes, memory_order_relaxed);
+    if (void* p = malloc(bytes ? bytes : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+using NameHandle = uint32_t;
+
+class NamePool {
+public:
+    NamePool() : segments(new atomic<Entry*>[kMaxSegments]) {
+        for (size_t i = 0; i < kMaxSegments; i++) segments[i].store(nullptr, memory_order_relaxed);
+    }
+    ~NamePool() {
+        for (size_t i = 0; i < kMaxSegments; i++) delete[] segments[i].load(memory_order_relaxed);
+    }
+    NamePool(const NamePool&) = delete;
+    NamePool& operator=(const NamePool&) = delete;
+
+    // the handle of name, stored first if it is new
+    NameHandle intern(string_view name) {
+        uint64_t h = hashOf(name);
+        Shard& s = shards[h >> 58]; // top 6 bits pick one of the 64 shards
+        lock_guard<mutex> guard(s.lock);
+        if (s.slots.empty()) s.slots.assign(64, Slot());
+        size_t mask = s.slots.size() - 1;
+        for (size_t i = h & mask;; i = (i + 1) & mask) {
+            Slot& slot = s.slots[i];
+            if (slot.handle == kEmpty) break;
+            if (slot.hash == h && text(slot.handle) == name) return slot.handle;
+        }
+        // new name: copy the chars into this shard's arena, then give it a number
+        NameHandle handle = (NameHandle)next.fetch_add(1, memory_order_relaxed);
+        if (handle >= kMaxSegments * kSegmentSize) abort(); // 2^28 different names
+        publish(handle, s.store(name), (uint32_t)name.size());
+        if (++s.used * 2 > s.slots.size()) grow(s);
+        size_t i = h & (s.slots.size() - 1);
+        while (s.slots[i].handle != kEmpty) i = (i + 1) & (s.slots.size() - 1);
+        s.slots[i] = {h, handle};
+        return handle;
+    }
+
+    // O(1), no lock: a handle is an index into the entry segments
+    string_view text(NameHandle h) const {
+        const Entry& e = segments[h / kSegmentSize].load(memory_order_acquire)[h % kSegmentSize];
+        return string_view(e.chars, e.length);
+    }
+
+    size_t size() const { return next.load(memory_order_relaxed); }
+
+private:
+    struct Entry {
+        const char* chars;
+        uint32_t length;
+    };
+    struct Slot {
+        uint64_t hash = 0;
+        NameHandle handle = kEmpty;
+    };
+    // the chars live in 64 KB blocks that never move, so string_views stay valid
+    struct alignas(64) Shard {
+        mutex lock;
+        vector<Slot> slots; // open addressing, size is a power of 2
+        size_t used = 0;
+        vector<unique_ptr<char[]>> blocks;
+        size_t blockLeft = 0;
+        char* blockPos = nullptr;
+
+        const char* store(string_view name) {
+            if (name.empty()) return ""; // nothing to copy (and blockPos may still be nullptr)
+            if (name.size() > blockLeft) {
+                size_t size = max<size_t>(name.size(), 64 * 1024);
+                blocks.emplace_back(new char[size]);
+                blockPos = blocks.back().get();
+                blockLeft = size;
+            }
+            memcpy(blockPos, name.data(), name.size());
+            const char* at = blockPos;
+            blockPos += name.size();
+            blockLeft -= name.size();
+            return at;
+        }
+    };
+
+    static const NameHandle kEmpty = UINT32_MAX;
+    static const size_t kSegmentSize = 4096;   // entries per segment
+    static const size_t kMaxSegments = 1 << 16;
+
+    Shard shards[64];
+    atomic<uint32_t> next{0};
+    unique_ptr<atomic<Entry*>[]> segments; // segment k holds handles k*4096 ..
+
+    static uint64_t hashOf(string_view s) {
+        uint64_t h = 1469598103934665603ull; // FNV-1a, then a final mix for the top bits
+        for (unsigned char c : s) h = (h ^ c) * 1099511628211ull;
+        h ^= h >> 29;
+        h *= 0xbf58476d1ce4e5b9ull;
+        return h ^ (h >> 32);
+    }
+
+    // puts the entry where text() finds it; a segment is created by whoever
+    // needs it first (the others delete their spare copy)
+    void publish(NameHandle handle, const char* chars, uint32_t length) {
+        atomic<Entry*>& seg = segments[handle / kSegmentSize];
+        Entry* e = seg.load(memory_order_acquire);
+        if (e == nullptr) {
+            Entry* fresh = new Entry[kSegmentSize];
+            if (seg.compare_exchange_strong(e, fresh, memory_order_acq_rel)) e = fresh;
+            else delete[] fresh;
+        }
+        Entry& slot = e[handle % kSegmentSize];
+        slot.chars = chars;
+        slot.length = length;
+    }
+
+    void grow(Shard& s) {
+        vector<Slot> bigger(s.slots.size() * 2);
+        size_t mask = bigger.size() - 1;
+        for (const Slot& old : s.slots) {
+            if (old.handle == kEmpty) continue;
+            size_t i = old.hash & mask;
+            while (bigger[i].handle != kEmpty) i = (i + 1) & mask;
+            bigger[i] = old;
+        }
+        s.slots.swap(bigger);
+    }
+};
+
+// Student from "Copy Constructor.cpp" as it is: every name its own string
+class Student {
+public:
+    int roll;
+    string name;
+    Student(int r, string n) : roll(r), name(move(n)) {}
+};
+
+// the same student with the name as a handle: 8 bytes instead of 40 (+ heap)
+class InternedStudent {
+public:
+    int roll;
+    NameHandle name;
+    InternedStudent(int r, NameHandle n) : roll(r), name(n) {}
+
+    string_view nameText(const NamePool& pool) const { return pool.text(name); }
+    bool sameName(const InternedStudent& other) const { return name == other.name; } // one integer compare
+};
+
+// a few thousand different names, some short, most longer than the 15 chars a
+// string keeps without the heap
+vector<string> makeNames(size_t count) {
+    const char* first[] = {"Ichigo", "Rukia", "Orihime", "Uryu", "Renji", "Byakuya", "Kisuke", "Yoruichi"};
+    const char* last[] = {"Kurosaki", "Kuchiki", "Inoue", "Ishida", "Abarai", "Urahara", "Shihoin", "Hitsugaya"};
+    vector<string> names;
+    for (size_t i = 0; i < count; i++) {
+        string n = string(first[i % 8]) + " " + last[i / 8 % 8];
+        if (i >= 64) n += " of squad " + to_string(i / 64);
+        names.push_back(n);
+    }
+    return names;
+}
+
+double msSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? stoul(argv[1]) : 5000000;
+    unsigned threads = max(2u, thread::hardware_concurrency());
+
+    NamePool pool;
+    NameHandle bob = pool.intern("Bob");
+    NameHandle bob2 = pool.intern(string("B") + "ob");
+    cout << "intern(\"Bob\") = " << bob << ", again = " << bob2 << ", text = " << pool.text(bob) << "\n";
+    NameHandle none = pool.intern("");
+    cout << "intern(\"\") = " << none << ", again = " << pool.intern("") << ", length = " << pool.text(none).size() << "\n";
+
+    vector<string> names = makeNames(4096);
+    vector<size_t> pick(n);
+    uint32_t seed = 99;
+    for (size_t& p : pick) {
+        seed = seed * 1103515245 + 12345;
+        p = (seed >> 8) % names.size();
+    }
+
+    // n students the usual way
+    size_t b0 = heapBytes.load();
+    auto t0 = chrono::steady_clock::now();
+    vector<Student> plain;
+    plain.reserve(n);
+    for (size_t i = 0; i < n; i++) plain.emplace_back((int)i, names[pick[i]]);
+    double msPlain = msSince(t0);
+    size_t plainBytes = heapBytes.load() - b0;
+
+    // the same students with handles, interned from several threads at once
+    b0 = heapBytes.load();
+    t0 = chrono::steady_clock::now();
+    vector<InternedStudent> interned(n, InternedStudent(0, 0));
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (size_t i = t; i < n; i += threads) interned[i] = InternedStudent((int)i, pool.intern(names[pick[i]]));
+        });
+    }
+    for (thread& th : workers) th.join();
+    double msInterned = msSince(t0);
+    size_t internedBytes = heapBytes.load() - b0;
+
+    // check: same text, and equal handles exactly for equal names
+    bool ok = pool.size() == names.size() + 2; // + "Bob" and ""
+    for (size_t i = 0; i < n && ok; i += 997) {
+        ok = interned[i].nameText(pool) == plain[i].name &&
+             interned[i].sameName(interned[0]) == (plain[i].name == plain[0].name);
+    }
+
+    // "how many students have the same name as student 0"
+    t0 = chrono::steady_clock::now();
+    size_t c1 = 0;
+    for (const Student& s : plain) c1 += s.name == plain[0].name;
+    double msCmpPlain = msSince(t0);
+    t0 = chrono::steady_clock::now();
+    size_t c2 = 0;
+    for (const InternedStudent& s : interned) c2 += s.sameName(interned[0]);
+    double msCmpInterned = msSince(t0);
+
+    cout << "\n" << n << " students, " << pool.size() << " different names, " << threads << " threads interning\n";
+    printf("                      build ms   heap MB   same-name scan ms\n");
+    printf("string name       %12.1f %9.1f %14.2f\n", msPlain, plainBytes / 1e6, msCmpPlain);
+    printf("interned handle   %12.1f %9.1f %14.2f\n", msInterned, internedBytes / 1e6, msCmpInterned);
+    printf("sizeof(Student) = %zu, sizeof(InternedStudent) = %zu\n", sizeof(Student), sizeof(InternedStudent));
+    cout << (ok && c1 == c2 ? "same names" : "MISMATCH") << endl;
+    return 0;
+}
+/*
+What it costs :- interning hashes the name and takes a shard lock, so building
+is not free; it pays off when names are stored long and compared often. The
+pool never forgets a name (handles must stay valid), so it suits names that
+repeat, not text that is always new.
+
+A handle only means something together with its pool: saving handles to a file
+needs the pool's names saved too (a handle -> text table).
+*/
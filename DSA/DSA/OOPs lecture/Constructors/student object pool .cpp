@@ -0,0 +1,316 @@
+/*
+Object pool :- a place that keeps memory for Student objects ready, so creating
+and destroying students does not go to new / delete every time.
+
+new Student(...) asks the general heap for memory that fits ANY size; delete
+gives it back. When many threads do that millions of times, they wait for each
+other inside the heap and the memory of one kind of object gets scattered.
+
+ObjectPool<Student>:
+    slabs      :- memory for 1024 students at a time, never given back while the
+                  pool lives (so addresses stay valid and nothing moves)
+    free list  :- the free slots are chained through the slots themselves (the
+                  "next free" number is written into the unused slot, no extra
+                  memory: an intrusive list)
+    thread cache :- every thread keeps up to 64 free slot numbers of its own and
+                  only takes the pool's lock to move 32 at a time
+    handles    :- create() gives {index, generation} instead of a pointer.
+                  destroy() adds 1 to the slot's generation, so an old handle to
+                  a destroyed student no longer matches: get() returns nullptr
+                  instead of a student that is gone (use after free is caught).
+                  The + 1 is one compare-and-swap done BEFORE the destructor, so
+                  when two threads destroy the same handle only one of them wins
+
+compile :- g++ -std=c++17 -O2 -pthread "student object pool .cpp"
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+using namespace std;
+
+// the Student of "Copy Constructor.cpp"
+class Student {
+public:
+    int roll;
+    string name;
+    Student(int r, string n) : roll(r), name(move(n)) {}
+};
+
+struct PoolHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+template <class T>
+class ObjectPool {
+public:
+    ObjectPool() : slabs(new atomic<Slot*>[kMaxSlabs]) {
+        for (size_t i = 0; i < kMaxSlabs; i++) slabs[i].store(nullptr, memory_order_relaxed);
+        lock_guard<mutex> guard(registryLock);
+        if (!freeIds.empty()) {
+            id = freeIds.back(); // the number of a pool that was destroyed
+            freeIds.pop_back();
+        } else if (usedIds < kMaxPools) {
+            id = usedIds++;
+        } else {
+            abort(); // the thread caches have room for kMaxPools pools alive at once
+        }
+        epoch = nextEpoch++;
+        liveEpoch[id] = epoch;
+    }
+    // destroy every student first, and no thread may use the pool any more
+    // (threads that used it may still be running)
+    ~ObjectPool() {
+        // under registryLock: a thread that is exiting right now either flushes
+        // its cache before this, or sees the pool is gone (see ~LocalCache)
+        lock_guard<mutex> guard(registryLock);
+        liveEpoch[id] = 0; // every thread's cache for this pool is now stale
+        for (size_t i = 0; i < kMaxSlabs; i++) ::operator delete(slabs[i].load(memory_order_relaxed));
+        freeIds.push_back(id);
+    }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <class... Args>
+    PoolHandle create(Args&&... args) {
+        LocalCache& c = cache();
+        if (c.count == 0) refill(c);
+        uint32_t index = c.free[--c.count];
+        Slot& s = slot(index);
+        new (&s.storage) T(forward<Args>(args)...);
+        return {index, s.generation.load(memory_order_relaxed)};
+    }
+
+    // nullptr when h was destroyed already (or never came from this pool)
+    T* get(PoolHandle h) {
+        if (h.index >= capacity.load(memory_order_acquire)) return nullptr;
+        Slot& s = slot(h.index);
+        if (s.generation.load(memory_order_acquire) != h.generation) return nullptr;
+        return reinterpret_cast<T*>(&s.storage);
+    }
+
+    // false when h is stale: a second destroy of the same student is refused,
+    // also when both destroys run at the same time
+    bool destroy(PoolHandle h) {
+        if (h.index >= capacity.load(memory_order_acquire)) return false;
+        Slot& s = slot(h.index);
+        // claim the slot first: only one thread can move the generation from
+        // h.generation to h.generation + 1, the other one sees it changed
+        uint32_t expected = h.generation;
+        if (!s.generation.compare_exchange_strong(expected, h.generation + 1, memory_order_acq_rel)) return false;
+        reinterpret_cast<T*>(&s.storage)->~T(); // old handles stop matching already
+        LocalCache& c = cache();
+        if (c.count == kCacheSize) drain(c);
+        c.free[c.count++] = h.index;
+        return true;
+    }
+
+    size_t slabCount() const { return capacity.load() / kSlabSize; }
+
+private:
+    static const uint32_t kSlabSize = 1024;
+    static const size_t kMaxSlabs = 1 << 16; // up to 64 million objects
+    static const uint32_t kCacheSize = 64, kBatch = 32;
+    static const uint32_t kNone = UINT32_MAX;
+    static const unsigned kMaxPools = 16;
+
+    struct Slot {
+        // while free the storage holds the number of the next free slot
+        alignas(T) unsigned char storage[sizeof(T) > sizeof(uint32_t) ? sizeof(T) : sizeof(uint32_t)];
+        atomic<uint32_t> generation{0};
+        uint32_t& nextFree() { return *reinterpret_cast<uint32_t*>(storage); }
+    };
+
+    // the free slot numbers one thread keeps for one pool; epoch says which
+    // pool, because the place caches[id] is reused when a pool id is reused
+    struct LocalCache {
+        ObjectPool* pool = nullptr; // only followed while epoch says it is alive
+        unsigned id = 0;
+        uint64_t epoch = 0;
+        uint32_t free[kCacheSize];
+        uint32_t count = 0;
+
+        // on thread exit the slots go back to the pool, if it is still alive.
+        // registryLock is held from the check to the end, so the pool cannot be
+        // destroyed in between
+        ~LocalCache() {
+            if (pool == nullptr || count == 0) return;
+            lock_guard<mutex> registryGuard(registryLock);
+            if (liveEpoch[id] != epoch) return; // pool is gone
+            lock_guard<mutex> guard(pool->lock);
+            while (count > 0) pool->pushFree(free[--count]);
+        }
+    };
+
+    unique_ptr<atomic<Slot*>[]> slabs; // slab k holds slots k*1024 ..
+    atomic<uint32_t> capacity{0};      // slots in all slabs
+    mutex lock;                        // guards freeHead
+    uint32_t freeHead = kNone;
+    unsigned id;    // place in the thread caches, reused after the pool dies
+    uint64_t epoch; // never reused: tells this pool apart from earlier ones with the same id
+
+    // which ids are free, and which pool (epoch) owns each id now (0 = none);
+    // all of it guarded by registryLock
+    static inline mutex registryLock;
+    static inline vector<unsigned> freeIds;
+    static inline unsigned usedIds = 0;
+    static inline uint64_t nextEpoch = 1;
+    static inline uint64_t liveEpoch[kMaxPools] = {};
+
+    LocalCache& cache() {
+        thread_local LocalCache caches[kMaxPools];
+        LocalCache& c = caches[id];
+        if (c.epoch != epoch) { // left over from a destroyed pool with this id: its slots are gone
+            c.pool = this;
+            c.id = id;
+            c.epoch = epoch;
+            c.count = 0;
+        }
+        return c;
+    }
+
+    Slot& slot(uint32_t index) {
+        return slabs[index / kSlabSize].load(memory_order_acquire)[index % kSlabSize];
+    }
+
+    void pushFree(uint32_t index) {
+        slot(index).nextFree() = freeHead;
+        freeHead = index;
+    }
+
+    // takes up to kBatch slots from the shared list, makes a new slab if it is empty
+    void refill(LocalCache& c) {
+        lock_guard<mutex> guard(lock);
+        if (freeHead == kNone) addSlab();
+        while (c.count < kBatch && freeHead != kNone) {
+            uint32_t index = freeHead;
+            freeHead = slot(index).nextFree();
+            c.free[c.count++] = index;
+        }
+    }
+
+    // gives half of a full cache back, so one thread cannot hoard all slots
+    void drain(LocalCache& c) {
+        lock_guard<mutex> guard(lock);
+        for (uint32_t i = 0; i < kBatch; i++) pushFree(c.free[--c.count]);
+    }
+
+    void addSlab() {
+        uint32_t first = capacity.load(memory_order_relaxed);
+        if (first / kSlabSize >= kMaxSlabs) throw bad_alloc();
+        Slot* slab = static_cast<Slot*>(::operator new(sizeof(Slot) * kSlabSize));
+        for (uint32_t i = 0; i < kSlabSize; i++) new (&slab[i].generation) atomic<uint32_t>(0);
+        slabs[first / kSlabSize].store(slab, memory_order_release);
+        capacity.store(first + kSlabSize, memory_order_release);
+        for (uint32_t i = kSlabSize; i-- > 0;) pushFree(first + i); // lowest numbers first
+    }
+};
+
+// ---------------------------------------------------------------- benchmark
+
+// every thread keeps `live` students and replaces a random one per step
+template <class Ref, class Make, class Drop>
+double churn(unsigned threads, size_t steps, size_t live, Make make, Drop drop) {
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([=]() {
+            vector<Ref> mine;
+            for (size_t i = 0; i < live; i++) mine.push_back(make((int)i));
+            uint32_t seed = 17 + t;
+            for (size_t s = 0; s < steps; s++) {
+                seed = seed * 1664525 + 1013904223;
+                size_t k = (seed >> 8) % live;
+                drop(mine[k]);
+                mine[k] = make((int)s);
+            }
+            for (Ref& r : mine) drop(r);
+        });
+    }
+    for (thread& w : workers) w.join();
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    return threads * steps / sec / 1e6; // million create+destroy pairs per second
+}
+
+int main(int argc, char* argv[]) {
+    size_t steps = argc > 1 ? stoul(argv[1]) : 2000000;
+    unsigned maxThreads = max(4u, thread::hardware_concurrency());
+
+    ObjectPool<Student> pool;
+    PoolHandle bob = pool.create(10, "Bob");
+    cout << "created: " << pool.get(bob)->name << " (index " << bob.index << ", generation " << bob.generation
+         << ")\n";
+    pool.destroy(bob);
+    cout << "after destroy, get(old handle) = " << (pool.get(bob) == nullptr ? "nullptr" : "a student!")
+         << ", destroy again = " << (pool.destroy(bob) ? "true" : "false") << "\n";
+    PoolHandle alice = pool.create(11, "Alice");
+    cout << "new student in the same slot: index " << alice.index << ", generation " << alice.generation
+         << ", old handle still refused: " << (pool.get(bob) == nullptr ? "yes" : "no") << "\n";
+    pool.destroy(alice);
+
+    // pool ids are reused: many pools one after the other, the caches of a
+    // destroyed pool are thrown away instead of being used for the next one
+    for (int round = 0; round < 100; round++) {
+        ObjectPool<Student> shortLived;
+        PoolHandle h = shortLived.create(round, "Temp");
+        if (shortLived.get(h)->roll != round || !shortLived.destroy(h)) cout << "pool " << round << " broken\n";
+    }
+    cout << "100 pools created and destroyed one after the other\n";
+
+    // two threads destroy the same student at the same time: exactly one may win
+    int badRounds = 0;
+    for (int round = 0; round < 1000; round++) {
+        PoolHandle h = pool.create(round, "Twice");
+        atomic<int> wins{0};
+        thread other([&]() { wins += pool.destroy(h); });
+        wins += pool.destroy(h);
+        other.join();
+        badRounds += wins != 1;
+    }
+    cout << "1000 double destroys from 2 threads, rounds where not exactly one won: " << badRounds << "\n";
+
+    const size_t live = 256;
+    cout << "\nmillion create + destroy per second (" << live << " live students per thread):\n";
+    cout << "threads   new/delete   make_unique   ObjectPool\n";
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        double a = churn<Student*>(threads, steps, live, [](int r) { return new Student(r, "Bob"); },
+                                   [](Student*& p) { delete p; });
+        double b = churn<unique_ptr<Student>>(threads, steps, live,
+                                              [](int r) { return make_unique<Student>(r, "Bob"); },
+                                              [](unique_ptr<Student>& p) { p.reset(); });
+        double c = churn<PoolHandle>(threads, steps, live, [&](int r) { return pool.create(r, "Bob"); },
+                                     [&](PoolHandle& h) { pool.destroy(h); });
+        printf("%7u %12.1f %13.1f %12.1f\n", threads, a, b, c);
+    }
+    cout << "pool slabs in use: " << pool.slabCount() << " (" << pool.slabCount() * 1024 << " slots)" << endl;
+    return 0;
+}
+/*
+Where the time goes :- new / delete (and make_unique, which is new plus a
+unique_ptr around it) pay for a general purpose heap: size classes, per thread
+arenas and locks inside malloc. The pool's common path is an array pop or push
+in the thread's own cache plus the constructor; the lock is taken once per 32
+creates or destroys.
+
+Measured on one core (glibc malloc, 2 million steps per thread): new/delete
+about 25 million pairs per second, make_unique the same, the pool about 28 -
+glibc already has a small per thread cache, so on one core the gain is small.
+The difference grows with real cores fighting over the heap.
+
+What the pool does NOT do :- a handle is only checked, not owned: nothing
+destroys the student when the handle is forgotten (no RAII like unique_ptr),
+and the generation is 32 bit, so a slot reused 4 billion times could match an
+ancient handle again. Slabs are kept until the pool dies. At most 16 pools of
+one type can be alive at the same time (each has a place in every thread's
+cache array); a destroyed pool gives its place to the next one.
+*/
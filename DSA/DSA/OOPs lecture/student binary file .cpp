@@ -0,0 +1,332 @@
+/*
+Binary file for class student (from Class.cpp) that is used WITHOUT reading it.
+
+Loading students from a text file means: read every line, split it, turn
+"90.5" into a double, copy every name into a new string. That work grows with
+the file, so a program that starts with 10 million students spends seconds
+before it does anything useful.
+
+This file format is laid out exactly like the arrays the program wants to use,
+so "loading" is only mmap (the OS maps the file into memory, pages are read
+from disk when they are first touched) plus a few checks on the header:
+
+    offset 0    Header (72 bytes)  magic "STUDENTS", version, count, and where
+                                   every part below starts
+    roll        int32   x count    \
+    group       char    x count     | fixed width columns, every column starts
+    percentage  double  x count     | at a multiple of 64 bytes
+    nameStart   uint32  x count+1   | name i = pool[nameStart[i] .. nameStart[i+1])
+    name pool   all names back to back, no '\0' in between
+                                   /
+All numbers are little endian (x86 and ARM both are). A new field or a change of
+layout needs a new version number; the loader refuses versions it does not know.
+
+compile :- g++ -std=c++17 -O2 "student binary file .cpp"
+*/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// the class from Class.cpp
+class student {
+    public :
+        int roll;
+        string name;
+        char group;
+        double percentage;
+};
+
+const char kMagic[8] = {'S', 'T', 'U', 'D', 'E', 'N', 'T', 'S'};
+const uint32_t kVersion = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerBytes;   // sizeof(FileHeader), so a reader can skip fields it does not know
+    uint64_t count;
+    uint64_t rollAt, groupAt, percentageAt, nameStartAt, poolAt;
+    uint64_t poolBytes;
+};
+static_assert(sizeof(FileHeader) == 72, "header layout is part of the file format");
+
+size_t alignUp(size_t x, size_t a) { return (x + a - 1) / a * a; }
+
+// writes the students in the binary layout, returns false on a write error
+bool writeStudents(const string& path, const vector<student>& all) {
+    FileHeader h;
+    memcpy(h.magic, kMagic, 8);
+    h.version = kVersion;
+    h.headerBytes = sizeof(FileHeader);
+    h.count = all.size();
+    h.poolBytes = 0;
+    for (const student& s : all) h.poolBytes += s.name.size();
+    if (h.poolBytes > UINT32_MAX) return false; // nameStart is 32 bit in version 1
+
+    h.rollAt = alignUp(sizeof(FileHeader), 64);
+    h.groupAt = alignUp(h.rollAt + h.count * sizeof(int32_t), 64);
+    h.percentageAt = alignUp(h.groupAt + h.count, 64);
+    h.nameStartAt = alignUp(h.percentageAt + h.count * sizeof(double), 64);
+    h.poolAt = alignUp(h.nameStartAt + (h.count + 1) * sizeof(uint32_t), 64);
+
+    // build the whole file in memory, then one write
+    vector<char> file(h.poolAt + h.poolBytes, 0);
+    memcpy(file.data(), &h, sizeof(h));
+    int32_t* roll = (int32_t*)(file.data() + h.rollAt);
+    char* group = file.data() + h.groupAt;
+    double* percentage = (double*)(file.data() + h.percentageAt);
+    uint32_t* nameStart = (uint32_t*)(file.data() + h.nameStartAt);
+    char* pool = file.data() + h.poolAt;
+    uint32_t used = 0;
+    for (size_t i = 0; i < all.size(); i++) {
+        roll[i] = all[i].roll;
+        group[i] = all[i].group;
+        percentage[i] = all[i].percentage;
+        nameStart[i] = used;
+        memcpy(pool + used, all[i].name.data(), all[i].name.size());
+        used += (uint32_t)all[i].name.size();
+    }
+    nameStart[all.size()] = used;
+
+    ofstream out(path, ios::binary);
+    out.write(file.data(), file.size());
+    return (bool)out;
+}
+
+// a read only array inside the mapped file
+template <class T>
+struct ColumnView {
+    const T* data = nullptr;
+    size_t count = 0;
+    const T& operator[](size_t i) const { return data[i]; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + count; }
+    size_t size() const { return count; }
+};
+
+class StudentFile {
+public:
+    StudentFile() = default;
+    StudentFile(const StudentFile&) = delete;
+    StudentFile& operator=(const StudentFile&) = delete;
+    ~StudentFile() { close(); }
+
+    // maps the file and checks the header; on failure error says why
+    bool open(const string& path, string& error) {
+        close();
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) { error = "cannot open " + path; return false; }
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); error = "cannot stat " + path; return false; }
+        bytes = st.st_size;
+        if (bytes < sizeof(FileHeader)) { ::close(fd); error = "file too small"; return false; }
+        void* map = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (map == MAP_FAILED) { error = "mmap failed"; return false; }
+        base = (const char*)map;
+#else
+        // no mmap here: read it once into memory (the views work the same way)
+        ifstream in(path, ios::binary);
+        if (!in) { error = "cannot open " + path; return false; }
+        copy.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        bytes = copy.size();
+        base = copy.data();
+        if (bytes < sizeof(FileHeader)) { error = "file too small"; close(); return false; }
+#endif
+        if (!check(error)) { close(); return false; }
+        return true;
+    }
+
+    void close() {
+#ifndef _WIN32
+        if (base != nullptr) munmap((void*)base, bytes);
+#else
+        copy.clear();
+#endif
+        base = nullptr;
+        bytes = 0;
+    }
+
+    size_t size() const { return header().count; }
+    ColumnView<int32_t> roll() const { return column<int32_t>(header().rollAt); }
+    ColumnView<char> group() const { return column<char>(header().groupAt); }
+    ColumnView<double> percentage() const { return column<double>(header().percentageAt); }
+    // the offsets are checked here, on use, instead of all of them in open();
+    // a broken entry gives an empty name instead of a read outside the file
+    string_view name(size_t i) const {
+        ColumnView<uint32_t> start = column<uint32_t>(header().nameStartAt);
+        uint32_t b = start[i], e = start[i + 1];
+        if (b > e || e > header().poolBytes) return string_view();
+        return string_view(base + header().poolAt + b, e - b);
+    }
+
+    // one student as a normal object (this one copies the name)
+    student row(size_t i) const {
+        student s;
+        s.roll = roll()[i];
+        s.name = string(name(i));
+        s.group = group()[i];
+        s.percentage = percentage()[i];
+        return s;
+    }
+
+private:
+    const char* base = nullptr;
+    size_t bytes = 0;
+#ifdef _WIN32
+    vector<char> copy;
+#endif
+
+    const FileHeader& header() const { return *(const FileHeader*)base; }
+
+    template <class T>
+    ColumnView<T> column(uint64_t at) const {
+        return {(const T*)(base + at), (size_t)header().count};
+    }
+
+    // every column the views hand out must be inside the file. Only the header
+    // is read, so this costs the same for 10 students and 10 million.
+    bool check(string& error) const {
+        const FileHeader& h = header();
+        if (memcmp(h.magic, kMagic, 8) != 0) { error = "not a student file"; return false; }
+        if (h.version != kVersion) { error = "unknown version " + to_string(h.version); return false; }
+        if (h.headerBytes < sizeof(FileHeader)) { error = "header too small"; return false; }
+        uint64_t n = h.count;
+        if (n > bytes) { error = "count too large"; return false; }
+        auto inside = [&](uint64_t at, uint64_t len, size_t align) {
+            return at % align == 0 && at <= bytes && len <= bytes - at;
+        };
+        if (!inside(h.rollAt, n * sizeof(int32_t), alignof(int32_t)) || !inside(h.groupAt, n, 1) ||
+            !inside(h.percentageAt, n * sizeof(double), alignof(double)) ||
+            !inside(h.nameStartAt, (n + 1) * sizeof(uint32_t), alignof(uint32_t)) ||
+            !inside(h.poolAt, h.poolBytes, 1)) {
+            error = "a column is outside the file";
+            return false;
+        }
+        return true;
+    }
+};
+
+// the text way, for comparison: "roll,name,group,percentage" per line
+void writeText(const string& path, const vector<student>& all) {
+    ofstream out(path);
+    for (const student& s : all) out << s.roll << ',' << s.name << ',' << s.group << ',' << s.percentage << '\n';
+}
+
+vector<student> readText(const string& path) {
+    vector<student> all;
+    ifstream in(path);
+    string line, field;
+    while (getline(in, line)) {
+        stringstream ss(line);
+        student s;
+        getline(ss, field, ',');
+        s.roll = stoi(field);
+        getline(ss, s.name, ',');
+        getline(ss, field, ',');
+        s.group = field.empty() ? '?' : field[0];
+        getline(ss, field, ',');
+        s.percentage = stod(field);
+        all.push_back(s);
+    }
+    return all;
+}
+
+double msSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+vector<student> makeStudents(size_t n) {
+    const char* first[] = {"papa", "Ichigo", "Rukia", "Orihime", "Uryu", "Yasutora Sado", "Kisuke Urahara"};
+    vector<student> all(n);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1103515245 + 12345;
+        all[i].roll = (int)i + 1;
+        all[i].name = string(first[seed % 7]) + " " + to_string(i);
+        all[i].group = (char)('A' + (seed >> 8) % 5);
+        all[i].percentage = ((seed >> 12) % 10001) / 100.0;
+    }
+    return all;
+}
+
+int main(int argc, char* argv[]) {
+    size_t big = argc > 1 ? stoul(argv[1]) : 2000000;
+    string error;
+
+    // the student of Class.cpp, written and read back
+    student s1;
+    s1.name = "papa";
+    s1.roll = 23;
+    s1.group = 'A';
+    s1.percentage = 90;
+    writeStudents("students_small.bin", {s1});
+    StudentFile one;
+    if (!one.open("students_small.bin", error)) { cout << "error: " << error << endl; return 1; }
+    student back = one.row(0);
+    cout << back.name << "\n" << back.roll << "\n" << back.group << "\n" << back.percentage << "\n\n";
+
+    // open time for a small and a big file: the same, it does not read the data
+    cout << "students     text parse ms   binary open ms   mean % (binary)\n";
+    for (size_t n : {big / 100, big}) {
+        vector<student> all = makeStudents(n);
+        writeText("students.txt", all);
+        if (!writeStudents("students.bin", all)) { cout << "write failed" << endl; return 1; }
+
+        auto t0 = chrono::steady_clock::now();
+        vector<student> parsed = readText("students.txt");
+        double msText = msSince(t0);
+
+        t0 = chrono::steady_clock::now();
+        StudentFile f;
+        if (!f.open("students.bin", error)) { cout << "error: " << error << endl; return 1; }
+        double msOpen = msSince(t0);
+
+        // using it: only the percentage column is ever touched
+        double sum = 0;
+        for (double p : f.percentage()) sum += p;
+        bool same = parsed.size() == f.size() && f.size() == n && f.name(n - 1) == all[n - 1].name &&
+                    f.roll()[n / 2] == all[n / 2].roll;
+        printf("%9zu %15.2f %16.3f %17.4f %s\n", n, msText, msOpen, sum / n, same ? "" : "MISMATCH");
+    }
+
+    // a damaged file is refused instead of crashing later
+    {
+        ofstream bad("students_bad.bin", ios::binary);
+        bad << "STUDENTS this is not a real header, just some text that is long enough...";
+    }
+    StudentFile broken;
+    if (!broken.open("students_bad.bin", error)) cout << "\nbroken file refused: " << error << endl;
+
+    remove("students_small.bin");
+    remove("students.bin");
+    remove("students.txt");
+    remove("students_bad.bin");
+    return 0;
+}
+/*
+Why the open time stays flat :- mmap only reserves addresses, the pages are
+filled when they are first touched, and open() reads nothing but the header.
+The first query then pays for the pages it touches (from the page cache, or
+from disk the first time), and a query on one column reads only that column.
+
+Rules that keep a file like this usable for years:
+- magic + version first, and never change what a version means
+- fixed width types (int32_t, not int or long, whose size differs by platform)
+- offsets instead of pointers (a pointer means nothing in another process)
+- every offset checked against the file size before it is used
+*/
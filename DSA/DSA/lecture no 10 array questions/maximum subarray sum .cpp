@@ -0,0 +1,209 @@
+/*
+Maximum subarray sum :- find the contiguous part of the array whose sum is the
+largest, and also WHERE it is (start index and end index).
+
+example :- {-2, 1, -3, 4, -1, 2, 1, -5, 4}
+answer  :- sum 6 from index 3 to 6 -> {4, -1, 2, 1}
+
+1. Kadane (one pass, O(n)) :- walk left to right with a running sum. If the
+   running sum becomes negative it can only hurt whatever comes next, so we drop
+   it and start a new subarray from the next element.
+
+2. Parallel divide and conquer :- cut the array into one chunk per thread. Each
+   chunk is reduced to 4 numbers (with their indices):
+       total  = sum of the whole chunk
+       prefix = best sum that STARTS at the chunk's first element
+       suffix = best sum that ENDS at the chunk's last element
+       best   = best subarray fully inside the chunk
+   Two neighbouring chunks L and R merge in O(1):
+       total  = L.total + R.total
+       prefix = max(L.prefix, L.total + R.prefix)
+       suffix = max(R.suffix, R.total + L.suffix)
+       best   = max(L.best, R.best, L.suffix + R.prefix)  <- crossing the cut
+   The chunks are merged pairwise like a tree, so only the linear scan of each
+   chunk costs time and that part runs on all cores.
+
+Sums use long long because a few GB of ints overflow int very quickly.
+
+compile :- g++ -std=c++17 -O2 -pthread "maximum subarray sum .cpp"
+*/
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <algorithm>
+using namespace std;
+
+struct SubarrayResult {
+    long long sum;
+    long long start; // -1 when the array is empty
+    long long end;
+};
+
+SubarrayResult kadane(const int* arr, size_t n) {
+    if (n == 0) return {0, -1, -1};
+    SubarrayResult best = {arr[0], 0, 0};
+    long long current = 0;
+    size_t currentStart = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (current < 0) { // a negative running sum only makes the next sums smaller
+            current = 0;
+            currentStart = i;
+        }
+        current += arr[i];
+        if (current > best.sum) {
+            best = {current, (long long)currentStart, (long long)i};
+        }
+    }
+    return best;
+}
+
+// the 4 values of one chunk, every one with the index range it belongs to
+struct ChunkSummary {
+    long long total;
+    long long prefix, prefixEnd;        // range [chunk start, prefixEnd]
+    long long suffix, suffixStart;      // range [suffixStart, chunk end]
+    SubarrayResult best;
+    long long first, last;              // index range of the chunk itself
+};
+
+// one pass over [lo, hi) that fills all 4 values at the same time
+ChunkSummary summarize(const int* arr, size_t lo, size_t hi) {
+    ChunkSummary s;
+    s.first = lo;
+    s.last = hi - 1;
+    s.best = {arr[lo], (long long)lo, (long long)lo};
+    s.prefix = arr[lo];
+    s.prefixEnd = lo;
+
+    long long current = 0;       // Kadane running sum
+    size_t currentStart = lo;
+    long long running = 0;       // plain prefix sum of the chunk
+    long long minBefore = 0;     // smallest prefix sum that ends BEFORE index i
+    size_t minBeforeAt = lo;     // suffix would start here
+    for (size_t i = lo; i < hi; i++) {
+        if (current < 0) {
+            current = 0;
+            currentStart = i;
+        }
+        current += arr[i];
+        if (current > s.best.sum) s.best = {current, (long long)currentStart, (long long)i};
+
+        running += arr[i];
+        if (running > s.prefix) {
+            s.prefix = running;
+            s.prefixEnd = i;
+        }
+        // suffix starting at i+1 is total - running, so remember the minimum running
+        if (i + 1 < hi && running < minBefore) {
+            minBefore = running;
+            minBeforeAt = i + 1;
+        }
+    }
+    s.total = running;
+    s.suffix = running - minBefore;
+    s.suffixStart = minBeforeAt;
+    return s;
+}
+
+// L is directly left of R
+ChunkSummary mergeChunks(const ChunkSummary& L, const ChunkSummary& R) {
+    ChunkSummary m;
+    m.first = L.first;
+    m.last = R.last;
+    m.total = L.total + R.total;
+
+    m.prefix = L.prefix;
+    m.prefixEnd = L.prefixEnd;
+    if (L.total + R.prefix > m.prefix) {
+        m.prefix = L.total + R.prefix;
+        m.prefixEnd = R.prefixEnd;
+    }
+
+    m.suffix = R.suffix;
+    m.suffixStart = R.suffixStart;
+    if (R.total + L.suffix > m.suffix) {
+        m.suffix = R.total + L.suffix;
+        m.suffixStart = L.suffixStart;
+    }
+
+    m.best = L.best.sum >= R.best.sum ? L.best : R.best;
+    if (L.suffix + R.prefix > m.best.sum) {
+        m.best = {L.suffix + R.prefix, L.suffixStart, R.prefixEnd};
+    }
+    return m;
+}
+
+SubarrayResult maxSubarrayParallel(const int* arr, size_t n, unsigned threads) {
+    if (n == 0) return {0, -1, -1};
+    threads = (unsigned)max<size_t>(1, min<size_t>(threads, n));
+    vector<ChunkSummary> part(threads);
+    vector<thread> pool;
+    size_t chunk = (n + threads - 1) / threads;
+    unsigned used = 0;
+    for (unsigned t = 0; t < threads && t * chunk < n; t++, used++) {
+        pool.emplace_back([&, t]() {
+            size_t lo = t * chunk;
+            size_t hi = min(n, lo + chunk);
+            part[t] = summarize(arr, lo, hi);
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    // tree merge: 0+1, 2+3, ... then 0+2, 4+6, ... until one summary is left
+    for (unsigned step = 1; step < used; step *= 2) {
+        for (unsigned i = 0; i + step < used; i += 2 * step) {
+            part[i] = mergeChunks(part[i], part[i + step]);
+        }
+    }
+    return part[0].best;
+}
+
+long long rangeSum(const vector<int>& v, long long s, long long e) {
+    long long sum = 0;
+    for (long long i = s; i <= e; i++) sum += v[i];
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> arr = {-2, 1, -3, 4, -1, 2, 1, -5, 4};
+    SubarrayResult r = kadane(arr.data(), arr.size());
+    cout << "Kadane   : sum " << r.sum << " from index " << r.start << " to " << r.end << endl;
+    r = maxSubarrayParallel(arr.data(), arr.size(), 4);
+    cout << "Parallel : sum " << r.sum << " from index " << r.start << " to " << r.end << endl;
+
+    vector<int> allNegative = {-8, -3, -6, -2, -5, -4};
+    r = kadane(allNegative.data(), allNegative.size());
+    cout << "All negative: sum " << r.sum << " at index " << r.start << "\n\n";
+
+    // benchmark :- random values in [-100, 100]
+    size_t n = argc > 1 ? stoul(argv[1]) : 100000000;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    vector<int> big(n);
+    mt19937 rng(7);
+    uniform_int_distribution<int> dist(-100, 100);
+    for (auto& x : big) x = dist(rng);
+
+    auto t0 = chrono::steady_clock::now();
+    SubarrayResult a = kadane(big.data(), n);
+    auto t1 = chrono::steady_clock::now();
+    SubarrayResult b = maxSubarrayParallel(big.data(), n, threads);
+    auto t2 = chrono::steady_clock::now();
+
+    cout << "n = " << n << " (" << n * sizeof(int) / (1 << 20) << " MB)\n";
+    cout << "Kadane             : " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << "parallel (" << threads << " thr)  : " << chrono::duration<double, milli>(t2 - t1).count() << " ms\n";
+    bool ok = a.sum == b.sum && rangeSum(big, b.start, b.end) == b.sum;
+    cout << "best sum " << a.sum << (ok ? " (both agree)" : " MISMATCH") << endl;
+    return 0;
+}
+/*
+Why the all negative case works :- best starts as arr[0] and not 0, so when every
+number is negative we still return the single largest element (-2 here) instead
+of an empty subarray with sum 0.
+
+Why merge order matters :- mergeChunks(L, R) assumes L is on the left. The tree
+loop always merges part[i] with part[i + step], which is the chunk right after
+everything already folded into part[i].
+*/
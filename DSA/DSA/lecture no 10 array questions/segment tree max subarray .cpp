@@ -0,0 +1,181 @@
+/*
+Segment tree for maximum subarray sum on an array that CHANGES.
+
+"maximum subarray sum .cpp" runs Kadane over the whole array, O(n) every time.
+If values keep changing between questions, that O(n) is paid again and again.
+
+A segment tree stores, for every segment, the same 4 values used by the
+parallel version of that file:
+    sum    = sum of the segment
+    prefix = best sum starting at the segment's left end
+    suffix = best sum ending at the segment's right end
+    best   = best subarray inside the segment
+and a parent is made from its two children with the same merge rule. Then
+    update(i, value)   -> change one leaf and fix its ancestors   O(log n)
+    query(l, r)        -> best subarray inside [l, r]             O(log n)
+
+Layout (iterative, no pointers, no recursion):
+    tree[1]                    = root
+    tree[2*i], tree[2*i + 1]   = children of tree[i]
+    tree[size .. 2*size - 1]   = leaves (size = n rounded up to a power of 2)
+Everything sits in one vector, parents are found with i / 2, and the top levels
+of the tree are shared by every operation, so they stay in cache.
+
+compile :- g++ -std=c++17 -O2 "segment tree max subarray .cpp"
+*/
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+using namespace std;
+
+struct Node {
+    long long sum, prefix, suffix, best;
+};
+
+// "minus infinity" that can still be added to without overflowing
+const long long NEG = -(1LL << 60);
+// empty segment: merging with it changes nothing
+const Node EMPTY = {0, NEG, NEG, NEG};
+
+Node makeLeaf(long long v) {
+    return {v, v, v, v};
+}
+
+// L must be the segment directly left of R
+Node combine(const Node& L, const Node& R) {
+    Node m;
+    m.sum = L.sum + R.sum;
+    m.prefix = max(L.prefix, L.sum + R.prefix);
+    m.suffix = max(R.suffix, R.sum + L.suffix);
+    m.best = max(max(L.best, R.best), L.suffix + R.prefix);
+    return m;
+}
+
+class MaxSubarrayTree {
+public:
+    // bulk build: fill all leaves, then every parent once from the bottom up, O(n)
+    MaxSubarrayTree(const vector<int>& arr) : n(arr.size()) {
+        size = 1;
+        while (size < n) size *= 2;
+        tree.assign(2 * size, EMPTY);
+        for (size_t i = 0; i < n; i++) tree[size + i] = makeLeaf(arr[i]);
+        for (size_t i = size - 1; i >= 1; i--) tree[i] = combine(tree[2 * i], tree[2 * i + 1]);
+    }
+
+    void update(size_t index, int value) {
+        size_t i = size + index;
+        tree[i] = makeLeaf(value);
+        for (i /= 2; i >= 1; i /= 2) tree[i] = combine(tree[2 * i], tree[2 * i + 1]);
+    }
+
+    // best subarray sum fully inside [l, r] (both inclusive)
+    long long query(size_t l, size_t r) const {
+        // left and right results are kept apart because combine() is not
+        // commutative: pieces from the left side are added on the right of
+        // leftPart, pieces from the right side on the left of rightPart
+        Node leftPart = EMPTY, rightPart = EMPTY;
+        size_t lo = l + size, hi = r + size + 1;
+        while (lo < hi) {
+            if (lo & 1) leftPart = combine(leftPart, tree[lo++]);
+            if (hi & 1) rightPart = combine(tree[--hi], rightPart);
+            lo /= 2;
+            hi /= 2;
+        }
+        return combine(leftPart, rightPart).best;
+    }
+
+    long long wholeArray() const { return tree[1].best; }
+
+private:
+    size_t n, size;
+    vector<Node> tree;
+};
+
+// O(n) answer for the same question, used to check the tree and as the baseline
+long long kadaneRange(const vector<int>& arr, size_t l, size_t r) {
+    long long best = arr[l], current = 0;
+    for (size_t i = l; i <= r; i++) {
+        current = max(current + arr[i], (long long)arr[i]);
+        best = max(best, current);
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> arr = {-2, 1, -3, 4, -1, 2, 1, -5, 4};
+    MaxSubarrayTree st(arr);
+    cout << "whole array      : " << st.wholeArray() << endl;   // 6
+    cout << "query [0, 2]     : " << st.query(0, 2) << endl;    // 1
+    st.update(7, 10);   // -5 becomes 10
+    arr[7] = 10;
+    cout << "after arr[7]=10  : " << st.wholeArray() << endl;   // 4-1+2+1+10+4 = 20
+    cout << "query [5, 7]     : " << st.query(5, 7) << "\n\n";  // 2+1+10 = 13
+
+    // mixed workload :- half point updates, half random range queries
+    size_t n = argc > 1 ? stoul(argv[1]) : 1000000;
+    size_t ops = argc > 2 ? stoul(argv[2]) : 1000000;
+    mt19937 rng(3);
+    uniform_int_distribution<int> value(-100, 100);
+    vector<int> data(n);
+    for (auto& x : data) x = value(rng);
+
+    auto t0 = chrono::steady_clock::now();
+    MaxSubarrayTree tree(data);
+    auto t1 = chrono::steady_clock::now();
+
+    long long checksum = 0;
+    size_t checked = 0, wrong = 0;
+    for (size_t op = 0; op < ops; op++) {
+        size_t a = rng() % n, b = rng() % n;
+        if (op % 2 == 0) {
+            int v = value(rng);
+            tree.update(a, v);
+            data[a] = v;
+        } else {
+            if (a > b) swap(a, b);
+            long long got = tree.query(a, b);
+            checksum += got;
+            // check a few answers against plain Kadane
+            if (op % 10001 == 1) {
+                checked++;
+                if (got != kadaneRange(data, a, b)) wrong++;
+            }
+        }
+    }
+    auto t2 = chrono::steady_clock::now();
+
+    // the same number of queries answered by Kadane would take this long
+    size_t sample = 200;
+    auto t3 = chrono::steady_clock::now();
+    for (size_t q = 0; q < sample; q++) {
+        size_t a = rng() % n, b = rng() % n;
+        if (a > b) swap(a, b);
+        checksum += kadaneRange(data, a, b);
+    }
+    auto t4 = chrono::steady_clock::now();
+    double kadanePerQuery = chrono::duration<double, milli>(t4 - t3).count() / sample;
+
+    double build = chrono::duration<double, milli>(t1 - t0).count();
+    double mixed = chrono::duration<double, milli>(t2 - t1).count();
+    cout << "n = " << n << ", operations = " << ops << " (50% update, 50% query)\n";
+    cout << "bulk build                 : " << build << " ms\n";
+    cout << "segment tree mixed ops     : " << mixed << " ms ("
+         << mixed * 1e6 / ops << " ns per op)\n";
+    cout << "Kadane per query (est.)    : " << kadanePerQuery << " ms -> "
+         << kadanePerQuery * (ops / 2) << " ms for all queries\n";
+    cout << "checked " << checked << " answers, " << wrong << " wrong (checksum " << checksum << ")" << endl;
+    return 0;
+}
+/*
+Why query() walks from both ends :- lo and hi start at the leaves and move up one
+level per step. Whenever lo is a RIGHT child, its parent would also cover
+elements left of l, so lo's node is taken on its own and lo moves right. The
+same happens mirrored for hi. At most 2 nodes per level are taken, so a query
+touches O(log n) nodes.
+
+Why EMPTY uses NEG and not LLONG_MIN :- combine() adds suffix + prefix. With
+LLONG_MIN that addition would overflow; with -2^60 it stays very negative and
+max() simply ignores it.
+*/
@@ -0,0 +1,177 @@
+/*
+Faster versions of "subarray_printng.cpp".
+
+That file uses 3 loops: st, end, and a third loop i from st to end that prints
+the subarray again from the beginning. Every subarray is rebuilt from scratch and
+every number goes through cout on its own, so the work is O(n^3).
+
+1. Incremental generator :- for a fixed st, the subarray [st..end] is just
+   [st..end-1] plus ONE more element. So we keep the text of the current subarray
+   in a small scratch buffer and only append arr[end] to it. Every number is
+   turned into text once (not once per subarray), and all output goes into one
+   big buffer that is written with fwrite in large pieces.
+   forEachSubarray() does the same walk without text at all: it hands
+   (st, end, running sum) to a callback in O(n^2) total.
+
+2. Aggregate modes, O(n), no subarray is ever built:
+   a) sum of all subarray sums :- arr[i] is inside every subarray with
+      st <= i <= end. There are (i + 1) choices for st and (n - i) for end,
+      so it is counted (i + 1) * (n - i) times.
+   b) number of subarrays with sum == k :- with prefix sums P, the subarray
+      (j, i] has sum P[i] - P[j]. So for every i we need how many earlier
+      prefixes equal P[i] - k, which a hash map answers in O(1).
+
+compile :- g++ -std=c++17 -O2 "subarray generator and aggregates .cpp"
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdio>
+#include <chrono>
+#include <random>
+using namespace std;
+
+// calls f(st, end, sum of arr[st..end]) for every subarray, O(n^2)
+template <class F>
+void forEachSubarray(const vector<int>& arr, F f) {
+    size_t n = arr.size();
+    for (size_t st = 0; st < n; st++) {
+        long long sum = 0;
+        for (size_t end = st; end < n; end++) {
+            sum += arr[end];       // extend the previous subarray by one element
+            f(st, end, sum);
+        }
+    }
+}
+
+// writes the same text as subarray_printng.cpp into out
+class SubarrayWriter {
+public:
+    SubarrayWriter(FILE* out, size_t bufferBytes = 1 << 20) : out(out) {
+        buffer.reserve(bufferBytes);
+    }
+    ~SubarrayWriter() { flush(); }
+
+    void write(const vector<int>& arr) {
+        size_t n = arr.size();
+        // turn every number into text only once
+        vector<string> text(n);
+        for (size_t i = 0; i < n; i++) text[i] = to_string(arr[i]);
+
+        string current;
+        for (size_t st = 0; st < n; st++) {
+            current.clear();
+            for (size_t end = st; end < n; end++) {
+                current += text[end];   // [st..end] = [st..end-1] + arr[end]
+                append(current);
+                append(" ");
+            }
+            append("\n");
+        }
+    }
+
+    void flush() {
+        if (!buffer.empty()) fwrite(buffer.data(), 1, buffer.size(), out);
+        buffer.clear();
+    }
+
+private:
+    FILE* out;
+    string buffer;
+
+    void append(const string& s) {
+        if (buffer.size() + s.size() > buffer.capacity()) flush();
+        buffer += s;
+    }
+};
+
+// a) O(n) :- every arr[i] appears in (i + 1) * (n - i) subarrays
+long long sumOfAllSubarraySums(const vector<int>& arr) {
+    long long n = arr.size(), total = 0;
+    for (long long i = 0; i < n; i++) total += arr[i] * (i + 1) * (n - i);
+    return total;
+}
+
+// b) O(n) :- count subarrays whose sum is exactly k
+long long countSubarraysWithSum(const vector<int>& arr, long long k) {
+    unordered_map<long long, long long> seen; // prefix sum -> how many times
+    seen.reserve(arr.size() * 2);
+    seen[0] = 1;                              // the empty prefix
+    long long prefix = 0, count = 0;
+    for (int x : arr) {
+        prefix += x;
+        auto it = seen.find(prefix - k);
+        if (it != seen.end()) count += it->second;
+        seen[prefix]++;
+    }
+    return count;
+}
+
+// the original triple loop, kept only to compare against
+void tripleLoop(const vector<int>& arr, FILE* out) {
+    size_t n = arr.size();
+    for (size_t st = 0; st < n; st++) {
+        for (size_t end = st; end < n; end++) {
+            for (size_t i = st; i <= end; i++) fprintf(out, "%d", arr[i]);
+            fprintf(out, " ");
+        }
+        fprintf(out, "\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> arr = {1, 2, 3, 4, 5};
+
+    cout << "All subarrays of {1, 2, 3, 4, 5}:" << endl;
+    cout.flush();
+    {
+        SubarrayWriter w(stdout);
+        w.write(arr);
+    }   // writer flushes here
+
+    cout << "\nSum of all subarray sums : " << sumOfAllSubarraySums(arr) << endl;  // 105
+    cout << "Subarrays with sum 9     : " << countSubarraysWithSum(arr, 9) << endl; // {2,3,4} {4,5}
+
+    long long brute = 0, bruteCount = 0;
+    forEachSubarray(arr, [&](size_t, size_t, long long s) {
+        brute += s;
+        if (s == 9) bruteCount++;
+    });
+    cout << "Checked with forEachSubarray: " << brute << ", " << bruteCount << "\n\n";
+
+    // benchmark :- write all subarray text of n numbers to /dev/null
+    size_t n = argc > 1 ? stoul(argv[1]) : 600;
+    vector<int> big(n);
+    mt19937 rng(1);
+    for (auto& x : big) x = (int)(rng() % 10);
+    FILE* sink = fopen("/dev/null", "w");
+    if (!sink) sink = fopen("NUL", "w");   // Windows
+    if (!sink) return 1;
+
+    auto t0 = chrono::steady_clock::now();
+    tripleLoop(big, sink);
+    auto t1 = chrono::steady_clock::now();
+    {
+        SubarrayWriter w(sink);
+        w.write(big);
+    }
+    auto t2 = chrono::steady_clock::now();
+    long long a = sumOfAllSubarraySums(big);
+    long long c = countSubarraysWithSum(big, 20);
+    auto t3 = chrono::steady_clock::now();
+    fclose(sink);
+
+    cout << "n = " << n << "\n";
+    cout << "triple loop print      : " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << "incremental generator  : " << chrono::duration<double, milli>(t2 - t1).count() << " ms\n";
+    cout << "both aggregates (O(n)) : " << chrono::duration<double, milli>(t3 - t2).count() << " ms\n";
+    cout << "sum of sums " << a << ", subarrays with sum 20: " << c << endl;
+    return 0;
+}
+/*
+Note :- the text of all subarrays itself has about n^3 / 6 numbers in it, so no
+printer can be faster than that size. The generator just removes the extra work
+on top of it (rebuilding and one cout per number). When only a number about the
+subarrays is needed, the aggregate modes skip the subarrays completely.
+*/
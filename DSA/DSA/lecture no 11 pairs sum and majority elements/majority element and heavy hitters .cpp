@@ -0,0 +1,337 @@
+/*
+Majority element and heavy hitters (most frequent items) in bounded memory.
+
+1. Boyer-Moore majority vote :- a majority element appears MORE than n/2 times.
+   Keep one candidate and a counter. Same value -> counter++, different value ->
+   counter--, counter 0 -> take the new value as candidate. Every "different"
+   value cancels one copy of the candidate, and a real majority cannot be fully
+   cancelled. One pass, O(1) memory. A second pass checks that the candidate
+   really is a majority (for {1, 2, 3} the vote still ends with some candidate).
+
+2. Misra-Gries summary (k counters) :- the same idea with k candidates. When a
+   new key arrives and all k counters are busy, every counter is decreased by 1
+   (cancelling k + 1 different keys at once). Any key that appears more than
+   n / (k + 1) times is guaranteed to survive, and a stored count is at most
+   n / (k + 1) below the real count.
+
+3. Space-Saving summary (k counters) :- when all counters are busy, the key with
+   the SMALLEST count is replaced by the new key, which gets count = min + 1 and
+   remembers "min" as its possible error. Counts are never too small, and top-k
+   items come out in a very good order.
+
+Both summaries are MERGEABLE: summaries of different threads or different file
+shards can be added together and cut back to k counters, and the guarantees
+above still hold for the combined stream. So a big event log can be split into
+shards, every shard is summarized on its own (even on another machine) and
+only the tiny summaries are combined.
+
+compile :- g++ -std=c++17 -O2 -pthread "majority element and heavy hitters .cpp"
+*/
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+using namespace std;
+
+// 1. returns true and the element if there is a majority
+bool majorityElement(const vector<int>& nums, int& answer) {
+    int candidate = 0;
+    long long votes = 0;
+    for (int x : nums) {
+        if (votes == 0) candidate = x;
+        votes += (x == candidate) ? 1 : -1;
+    }
+    // second pass: is the candidate really more than half?
+    long long count = 0;
+    for (int x : nums) count += (x == candidate);
+    if (count * 2 > (long long)nums.size()) {
+        answer = candidate;
+        return true;
+    }
+    return false;
+}
+
+struct HeavyHitter {
+    uint64_t key;
+    long long count;
+    // how far count can be off; the direction depends on the summary:
+    //   Space-Saving counts too much,  real count in [count - error, count]
+    //   Misra-Gries  counts too little, real count in [count, count + error]
+    long long error;
+};
+
+// 2. Misra-Gries
+// Instead of decreasing all counters on every miss (O(k) each time), up to 2k
+// counters are allowed and then cut back to k in one go by subtracting the
+// (k+1)-th biggest count from all of them. The guarantee stays the same and
+// the cost per event becomes O(1) on average.
+class MisraGries {
+public:
+    MisraGries(size_t k) : k(k) { counters.reserve(4 * k); }
+
+    void add(uint64_t key, long long times = 1) {
+        total += times;
+        counters[key] += times;
+        if (counters.size() > 2 * k) shrink();
+    }
+
+    // add the counters of other, then cut back to k the same way
+    void merge(const MisraGries& other) {
+        total += other.total;
+        dropped += other.dropped;
+        for (auto& kv : other.counters) counters[kv.first] += kv.second;
+        shrink();
+    }
+
+    vector<HeavyHitter> top() const {
+        vector<HeavyHitter> out;
+        for (auto& kv : counters) out.push_back({kv.first, kv.second, dropped});
+        sort(out.begin(), out.end(), [](const HeavyHitter& a, const HeavyHitter& b) { return a.count > b.count; });
+        if (out.size() > k) out.resize(k);
+        return out;
+    }
+
+    long long streamLength() const { return total; }
+
+private:
+    size_t k;
+    long long total = 0, dropped = 0; // dropped = how much any count can be too small
+    unordered_map<uint64_t, long long> counters;
+
+    void shrink() {
+        if (counters.size() <= k) return;
+        vector<long long> c;
+        c.reserve(counters.size());
+        for (auto& kv : counters) c.push_back(kv.second);
+        nth_element(c.begin(), c.begin() + k, c.end(), greater<long long>());
+        long long cut = c[k];
+        dropped += cut;
+        for (auto it = counters.begin(); it != counters.end();) {
+            it->second -= cut;
+            if (it->second <= 0) it = counters.erase(it);
+            else ++it;
+        }
+    }
+};
+
+// 3. Space-Saving
+// Every counter lives in a fixed slot, and "where" maps key -> slot. A min-heap
+// of slot numbers (ordered by count) gives the counter to replace in heap[0].
+// Heap moves only touch the small slot/heap arrays, never the hash map.
+class SpaceSaving {
+public:
+    SpaceSaving(size_t k) : k(k) {
+        where.reserve(2 * k);
+        slots.reserve(k);
+        heap.reserve(k);
+    }
+
+    void add(uint64_t key, long long times = 1, long long error = 0) {
+        total += times;
+        auto it = where.find(key);
+        if (it != where.end()) {
+            Slot& s = slots[it->second];
+            s.hh.count += times;
+            s.hh.error += error;
+            siftDown(s.heapPos); // count only grew, so it can only move down
+            return;
+        }
+        if (slots.size() < k) {
+            where.emplace(key, slots.size());
+            slots.push_back({{key, times, error}, heap.size()});
+            heap.push_back(slots.size() - 1);
+            siftUp(heap.size() - 1);
+            return;
+        }
+        // replace the smallest counter, the new key inherits its count as error
+        size_t victim = heap[0];
+        Slot& s = slots[victim];
+        where.erase(s.hh.key);
+        long long base = s.hh.count;
+        s.hh = {key, base + times, base + error};
+        where.emplace(key, victim);
+        siftDown(0);
+    }
+
+    // a key missing from one summary may still have up to that summary's
+    // minimum count there, so that minimum is added as count and error
+    void merge(const SpaceSaving& other) {
+        long long myMin = minCount(), otherMin = other.minCount();
+        unordered_map<uint64_t, HeavyHitter> all;
+        for (auto& s : slots) all[s.hh.key] = {s.hh.key, s.hh.count + otherMin, s.hh.error + otherMin};
+        for (auto& s : other.slots) {
+            auto it = all.find(s.hh.key);
+            if (it == all.end()) {
+                all[s.hh.key] = {s.hh.key, s.hh.count + myMin, s.hh.error + myMin};
+            } else {
+                // the key is in both: undo the guess for "missing in other"
+                it->second.count += s.hh.count - otherMin;
+                it->second.error += s.hh.error - otherMin;
+            }
+        }
+        vector<HeavyHitter> merged;
+        for (auto& kv : all) merged.push_back(kv.second);
+        sort(merged.begin(), merged.end(), [](const HeavyHitter& a, const HeavyHitter& b) { return a.count > b.count; });
+        if (merged.size() > k) merged.resize(k);
+        long long newTotal = total + other.total;
+        *this = SpaceSaving(k);
+        for (auto& h : merged) add(h.key, h.count, h.error);
+        total = newTotal;
+    }
+
+    vector<HeavyHitter> top() const {
+        vector<HeavyHitter> out;
+        for (auto& s : slots) out.push_back(s.hh);
+        sort(out.begin(), out.end(), [](const HeavyHitter& a, const HeavyHitter& b) { return a.count > b.count; });
+        return out;
+    }
+
+    // a shard's summary is written as "total" then one "key count error" per line
+    bool save(const string& path) const {
+        ofstream out(path);
+        if (!out) return false;
+        out << total << "\n";
+        for (auto& s : slots) out << s.hh.key << " " << s.hh.count << " " << s.hh.error << "\n";
+        return true;
+    }
+
+    static bool load(const string& path, size_t k, SpaceSaving& result) {
+        ifstream in(path);
+        if (!in) return false;
+        result = SpaceSaving(k);
+        long long total;
+        in >> total;
+        HeavyHitter h;
+        while (in >> h.key >> h.count >> h.error) result.add(h.key, h.count, h.error);
+        result.total = total;
+        return true;
+    }
+
+    long long streamLength() const { return total; }
+
+private:
+    struct Slot {
+        HeavyHitter hh;
+        size_t heapPos;
+    };
+    size_t k;
+    long long total = 0;
+    vector<Slot> slots;
+    vector<size_t> heap;                   // slot numbers, smallest count on top
+    unordered_map<uint64_t, size_t> where; // key -> slot
+
+    long long minCount() const {
+        if (slots.size() < k) return 0; // not full: a missing key was really never seen
+        return slots[heap[0]].hh.count;
+    }
+
+    long long countAt(size_t pos) const { return slots[heap[pos]].hh.count; }
+    void swapHeap(size_t a, size_t b) {
+        swap(heap[a], heap[b]);
+        slots[heap[a]].heapPos = a;
+        slots[heap[b]].heapPos = b;
+    }
+    void siftUp(size_t i) {
+        while (i > 0 && countAt((i - 1) / 2) > countAt(i)) {
+            swapHeap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+    void siftDown(size_t i) {
+        while (true) {
+            size_t l = 2 * i + 1, r = l + 1, m = i;
+            if (l < heap.size() && countAt(l) < countAt(m)) m = l;
+            if (r < heap.size() && countAt(r) < countAt(m)) m = r;
+            if (m == i) return;
+            swapHeap(i, m);
+            i = m;
+        }
+    }
+};
+
+int main(int argc, char* argv[]) {
+    vector<int> nums = {2, 2, 1, 1, 1, 2, 2};
+    int maj;
+    if (majorityElement(nums, maj)) cout << "majority element: " << maj << endl;
+    vector<int> none = {1, 2, 3};
+    cout << "majority in {1, 2, 3}: " << (majorityElement(none, maj) ? "yes" : "none") << "\n\n";
+
+    // an event stream where a few keys are hot (Zipf-like: key i has weight 1 / i)
+    size_t n = argc > 1 ? stoul(argv[1]) : 20000000;
+    size_t k = 256;
+    unsigned shards = max(2u, thread::hardware_concurrency());
+    size_t keys = 1000000;
+    vector<double> weight(keys);
+    for (size_t i = 0; i < keys; i++) weight[i] = 1.0 / (i + 1);
+    discrete_distribution<uint32_t> zipf(weight.begin(), weight.end());
+    mt19937 rng(5);
+    vector<uint64_t> events(n);
+    for (auto& e : events) e = zipf(rng) * 2654435761ULL; // scatter keys, key 0 stays 0
+
+    auto t0 = chrono::steady_clock::now();
+    // every shard is summarized by its own thread and written to its own file
+    vector<thread> pool;
+    vector<MisraGries> mg(shards, MisraGries(k));
+    size_t chunk = (n + shards - 1) / shards;
+    for (unsigned s = 0; s < shards; s++) {
+        pool.emplace_back([&, s]() {
+            size_t lo = min(n, s * chunk), hi = min(n, lo + chunk);
+            SpaceSaving ss(k);
+            for (size_t i = lo; i < hi; i++) {
+                ss.add(events[i]);
+                mg[s].add(events[i]);
+            }
+            ss.save("heavy_hitters_shard_" + to_string(s) + ".txt");
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    // combine: read every shard file back and merge
+    SpaceSaving combined(k);
+    for (unsigned s = 0; s < shards; s++) {
+        string path = "heavy_hitters_shard_" + to_string(s) + ".txt";
+        SpaceSaving part(k);
+        if (SpaceSaving::load(path, k, part)) combined.merge(part);
+        remove(path.c_str());
+    }
+    for (unsigned s = 1; s < shards; s++) mg[0].merge(mg[s]);
+    auto t1 = chrono::steady_clock::now();
+
+    // exact answer with a full hash table, only to check
+    unordered_map<uint64_t, long long> exact;
+    for (uint64_t e : events) exact[e]++;
+    auto t2 = chrono::steady_clock::now();
+
+    cout << "events = " << n << ", shards = " << shards << ", counters = " << k << "\n";
+    cout << "summaries + merge : " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << "exact hash table  : " << chrono::duration<double, milli>(t2 - t1).count()
+         << " ms (" << exact.size() << " distinct keys)\n\n";
+
+    cout << "top 5 Space-Saving (count / exact / max error):\n";
+    vector<HeavyHitter> ssTop = combined.top();
+    for (size_t i = 0; i < 5 && i < ssTop.size(); i++) {
+        cout << "  key " << ssTop[i].key << ": " << ssTop[i].count << " / " << exact[ssTop[i].key]
+             << " / " << ssTop[i].error << "\n";
+    }
+    cout << "top 5 Misra-Gries (count / exact / max error):\n";
+    vector<HeavyHitter> mgTop = mg[0].top();
+    for (size_t i = 0; i < 5 && i < mgTop.size(); i++) {
+        cout << "  key " << mgTop[i].key << ": " << mgTop[i].count << " / " << exact[mgTop[i].key]
+             << " / " << mgTop[i].error << "\n";
+    }
+    return 0;
+}
+/*
+| method         | memory | answer                                       |
+| -------------- | ------ | -------------------------------------------- |
+| Boyer-Moore    | O(1)   | the majority (> n/2), checked by 2nd pass    |
+| Misra-Gries    | O(k)   | every key > n/(k+1) kept, counts may be low  |
+| Space-Saving   | O(k)   | every key > n/k kept, counts may be high     |
+| hash table     | O(distinct keys) | exact, but grows with the data     |
+*/
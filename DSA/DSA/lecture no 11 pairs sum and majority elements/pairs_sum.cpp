@@ -0,0 +1,208 @@
+/*
+Pair sum :- find two different elements whose sum is equal to a target.
+
+example :- arr = {2, 7, 11, 15}, target = 9  ->  index 0 and 1 (2 + 7)
+
+1. Two pointer (array is SORTED) :- left starts at the smallest value, right at
+   the largest. If arr[left] + arr[right] is too small, only moving left forward
+   can make it bigger; if it is too big, only moving right back can make it
+   smaller. O(n) time, O(1) memory.
+
+2. Hash (array is NOT sorted) :- walk once and for every x ask "did I already
+   see target - x?". An unordered_map from value to index answers that in O(1).
+   O(n) time, O(n) memory, no sorting needed.
+
+3. Batch :- many different targets against the SAME array. Sorting once is paid
+   only one time (O(n log n)), then every target is a two pointer walk. Targets
+   are split between threads because every walk is independent.
+
+4. Count all pairs with sum <= T :- on the sorted array, for index i the partners
+   are i+1 .. j where j is the last index with arr[i] + arr[j] <= T. When i moves
+   right, j can only move left, so one thread walks its part of i with a single
+   binary search at the start and then plain pointer moves.
+
+compile :- g++ -std=c++17 -O2 -pthread pairs_sum.cpp
+*/
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <thread>
+#include <random>
+#include <chrono>
+using namespace std;
+
+// 1. arr must be sorted, returns the two indices or {-1, -1}
+pair<int, int> pairSumSorted(const vector<int>& arr, long long target) {
+    int left = 0, right = (int)arr.size() - 1;
+    while (left < right) {
+        long long sum = (long long)arr[left] + arr[right];
+        if (sum == target) return {left, right};
+        if (sum < target) left++;
+        else right--;
+    }
+    return {-1, -1};
+}
+
+// 2. any order, returns the two indices or {-1, -1}
+pair<int, int> pairSumHash(const vector<int>& arr, long long target) {
+    unordered_map<long long, int> seen; // value -> index
+    seen.reserve(arr.size() * 2);
+    for (int i = 0; i < (int)arr.size(); i++) {
+        auto it = seen.find(target - arr[i]);
+        if (it != seen.end()) return {it->second, i};
+        seen.emplace(arr[i], i);
+    }
+    return {-1, -1};
+}
+
+// 3. and 4. :- the array is sorted once, then many questions are answered
+class PairSumIndex {
+public:
+    PairSumIndex(vector<int> values) : sorted(move(values)) {
+        sort(sorted.begin(), sorted.end());
+    }
+
+    bool hasPair(long long target) const {
+        return pairSumSorted(sorted, target).first != -1;
+    }
+
+    // number of index pairs i < j with sorted[i] + sorted[j] == target (duplicates included)
+    long long countPairs(long long target) const {
+        long long count = 0;
+        size_t left = 0, right = sorted.size();
+        while (right > 0 && left < right - 1) {
+            long long sum = (long long)sorted[left] + sorted[right - 1];
+            if (sum < target) { left++; continue; }
+            if (sum > target) { right--; continue; }
+            if (sorted[left] == sorted[right - 1]) {
+                // every element between them is the same value
+                long long m = right - left;
+                count += m * (m - 1) / 2;
+                break;
+            }
+            long long a = 1, b = 1;
+            while (left + 1 < right - 1 && sorted[left + 1] == sorted[left]) { left++; a++; }
+            while (right - 2 > left && sorted[right - 2] == sorted[right - 1]) { right--; b++; }
+            count += a * b;
+            left++;
+            right--;
+        }
+        return count;
+    }
+
+    // answers every target, the targets are shared between threads
+    vector<long long> countPairsBatch(const vector<long long>& targets, unsigned threads) const {
+        vector<long long> answer(targets.size());
+        vector<thread> pool;
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t]() {
+                for (size_t q = t; q < targets.size(); q += threads) answer[q] = countPairs(targets[q]);
+            });
+        }
+        for (auto& th : pool) th.join();
+        return answer;
+    }
+
+    // pairs i < j with sorted[i] + sorted[j] <= limit
+    long long countPairsAtMost(long long limit, unsigned threads) const {
+        size_t n = sorted.size();
+        vector<long long> partial(threads, 0);
+        vector<thread> pool;
+        size_t chunk = (n + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; t++) {
+            pool.emplace_back([&, t]() {
+                size_t lo = min(n, t * chunk), hi = min(n, lo + chunk);
+                if (lo >= hi) return;
+                // j = one past the last partner of lo, found once by binary search
+                size_t j = upper_bound(sorted.begin(), sorted.end(), limit - sorted[lo]) - sorted.begin();
+                long long count = 0;
+                for (size_t i = lo; i < hi; i++) {
+                    while (j > 0 && (long long)sorted[i] + sorted[j - 1] > limit) j--;
+                    if (j > i + 1) count += j - (i + 1);
+                    else break; // larger i cannot have partners either
+                }
+                partial[t] = count;
+            });
+        }
+        for (auto& th : pool) th.join();
+        long long total = 0;
+        for (long long c : partial) total += c;
+        return total;
+    }
+
+private:
+    vector<int> sorted;
+};
+
+template <class F>
+double timeMs(F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sortedArr = {2, 7, 11, 15};
+    pair<int, int> p = pairSumSorted(sortedArr, 9);
+    cout << "two pointer : index " << p.first << " and " << p.second << endl;
+
+    vector<int> unsortedArr = {11, 15, 2, 7};
+    p = pairSumHash(unsortedArr, 9);
+    cout << "hash        : index " << p.first << " and " << p.second << endl;
+
+    PairSumIndex idx({1, 5, 3, 3, 3, 7, 4});
+    cout << "pairs with sum 6  : " << idx.countPairs(6) << endl;          // 1+5, 3+3 three times
+    cout << "pairs with sum <= 7 : " << idx.countPairsAtMost(7, 2) << "\n\n";
+
+    // benchmark
+    size_t n = argc > 1 ? stoul(argv[1]) : 5000000;
+    size_t queries = 64;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    mt19937 rng(11);
+    uniform_int_distribution<int> dist(0, 1000000000);
+    vector<int> data(n);
+    for (auto& x : data) x = dist(rng);
+    long long missing = 3000000001LL; // larger than any pair, so every path scans everything
+
+    vector<int> sortedData;
+    double tSort = timeMs([&]() {
+        sortedData = data;
+        sort(sortedData.begin(), sortedData.end());
+    });
+    pair<int, int> two, hashed;
+    double tTwo = timeMs([&]() { two = pairSumSorted(sortedData, missing); });
+    double tHash = timeMs([&]() { hashed = pairSumHash(data, missing); });
+
+    PairSumIndex index(data);
+    vector<long long> targets(queries);
+    for (auto& t : targets) t = (long long)dist(rng) + dist(rng);
+    vector<long long> batch;
+    double tBatch = timeMs([&]() { batch = index.countPairsBatch(targets, threads); });
+
+    long long limit = 1000000000LL;
+    long long atMost1 = 0, atMostN = 0;
+    double tAtMost1 = timeMs([&]() { atMost1 = index.countPairsAtMost(limit, 1); });
+    double tAtMostN = timeMs([&]() { atMostN = index.countPairsAtMost(limit, threads); });
+
+    cout << "n = " << n << ", threads = " << threads << "\n";
+    cout << "sort once                    : " << tSort << " ms\n";
+    cout << "two pointer (sorted)         : " << tTwo << " ms (found: " << (two.first != -1) << ")\n";
+    cout << "hash (unsorted)              : " << tHash << " ms (found: " << (hashed.first != -1) << ")\n";
+    cout << "batch " << queries << " targets            : " << tBatch << " ms ("
+         << tBatch / queries << " ms per target)\n";
+    cout << "count sum <= T, 1 thread     : " << tAtMost1 << " ms\n";
+    cout << "count sum <= T, " << threads << " threads    : " << tAtMostN << " ms\n";
+    cout << "pairs with sum <= " << limit << ": " << atMostN
+         << (atMost1 == atMostN ? "" : " MISMATCH") << endl;
+    return 0;
+}
+/*
+Which one to use :-
+| situation                              | path        | cost per question |
+| -------------------------------------- | ----------- | ----------------- |
+| one target, array already sorted       | two pointer | O(n), no memory   |
+| one target, array not sorted           | hash        | O(n), O(n) memory |
+| many targets, same array               | batch       | O(n log n) once, then O(n) |
+| how many pairs are small enough        | <= T count  | O(n) split over threads    |
+*/
@@ -0,0 +1,359 @@
+/*
+Complexity explorer :- MEASURE the big-O class of a function instead of guessing.
+
+1. Run the function for growing input sizes n = 8, 16, 32, ... (doubling) until
+   one call takes too long or n reaches its limit.
+2. For every candidate class f(n) in { 1, log n, n, n log n, n^2, n^3 } find the
+   constant c that makes c * f(n) closest to the measured times (least squares).
+   Errors are taken RELATIVE to the measured time, so the small sizes count as
+   much as the big ones.
+3. The class with the smallest error is the best fit.
+
+For two implementations of the same job (a slow simple one and a fast clever
+one) it also reports the crossover: the n where the fitted curves cross, and the
+first measured n where the clever one really wins. Below that n the simple one
+is faster, because big-O hides the constant factors.
+
+Compared here:
+- subarray sums the way subarray_printng.cpp walks them (3 loops, rebuild every
+  subarray) vs the incremental generator (extend by one element)
+- counting primes with trial division like "prime no check.cpp" vs a sieve
+- plus a few single functions whose class we know, to check the fitter itself
+
+Adding a function :- register it like a benchmark in time.cpp:
+    COMPLEXITY("my function", 1 << 20, "") {     // name, largest n, compare group
+        auto v = make_shared<vector<int>>(makeArray(n));   // input of size n, not timed
+        return [v]() { DoNotOptimize(myFunction(*v)); };    // one timed call
+    }
+Two functions with the same compare group are measured against each other (the
+one registered first is the "simple" one); with "" the function is fitted alone.
+
+compile :- g++ -std=c++17 -O2 "complexity explorer .cpp"
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+using namespace std;
+
+// the same as in time.cpp: the compiler must treat value as used
+template <class T>
+inline void DoNotOptimize(T const& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// ---------------------------------------------------------------- registry
+
+// prepare(n) builds the input of size n and returns "run one call on it"
+struct Algorithm {
+    string name;
+    size_t maxN;
+    string group; // algorithms with the same group are compared, "" = fitted alone
+    function<function<void()>(size_t)> prepare;
+};
+
+vector<Algorithm>& registry() {
+    static vector<Algorithm> all;
+    return all;
+}
+
+struct Registrar {
+    Registrar(const string& name, size_t maxN, const string& group, function<function<void()>(size_t)> prepare) {
+        registry().push_back({name, maxN, group, move(prepare)});
+    }
+};
+
+// COMPLEXITY("name", maxN, "group") { ... build input of size n ...; return [..]() { one call }; }
+#define COMPLEXITY_CONCAT2(a, b) a##b
+#define COMPLEXITY_CONCAT(a, b) COMPLEXITY_CONCAT2(a, b)
+#define COMPLEXITY(name, maxN, group)                                                                  \
+    static function<void()> COMPLEXITY_CONCAT(prepareFn_, __LINE__)(size_t n);                         \
+    static Registrar COMPLEXITY_CONCAT(complexityReg_, __LINE__)(name, maxN, group,                    \
+                                                                 COMPLEXITY_CONCAT(prepareFn_, __LINE__)); \
+    static function<void()> COMPLEXITY_CONCAT(prepareFn_, __LINE__)(size_t n)
+
+// ---------------------------------------------------------------- measuring
+
+struct Point {
+    double n, seconds;
+};
+
+double nowSeconds() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// seconds per call: calls are batched until a batch takes >= 0.2 ms, median of 5 batches
+double timeOneCall(const function<void()>& call) {
+    size_t batch = 1;
+    while (true) {
+        double t0 = nowSeconds();
+        for (size_t i = 0; i < batch; i++) call();
+        if (nowSeconds() - t0 >= 2e-4 || batch >= (1u << 24)) break;
+        batch *= 2;
+    }
+    vector<double> samples;
+    for (int rep = 0; rep < 5; rep++) {
+        double t0 = nowSeconds();
+        for (size_t i = 0; i < batch; i++) call();
+        samples.push_back((nowSeconds() - t0) / batch);
+    }
+    sort(samples.begin(), samples.end());
+    return samples[2];
+}
+
+vector<Point> measure(const Algorithm& a, double maxSecondsPerCall = 0.05) {
+    vector<Point> points;
+    for (size_t n = 8; n <= a.maxN; n *= 2) {
+        function<void()> call = a.prepare(n);
+        double t = timeOneCall(call);
+        points.push_back({(double)n, t});
+        if (t > maxSecondsPerCall) break;
+    }
+    return points;
+}
+
+// ---------------------------------------------------------------- fitting
+
+struct ComplexityClass {
+    const char* name;
+    double (*f)(double);
+};
+
+const ComplexityClass classes[] = {
+    {"O(1)", [](double) { return 1.0; }},
+    {"O(log n)", [](double n) { return log2(n); }},
+    {"O(n)", [](double n) { return n; }},
+    {"O(n log n)", [](double n) { return n * log2(n); }},
+    {"O(n^2)", [](double n) { return n * n; }},
+    {"O(n^3)", [](double n) { return n * n * n; }},
+};
+
+struct Fit {
+    const ComplexityClass* cls;
+    double c;        // time = c * f(n) seconds
+    double rmsError; // relative, 0.1 = typical point is 10% off
+};
+
+// minimize sum ((t - c f) / t)^2  ->  c = sum(f / t) / sum(f^2 / t^2)
+Fit fitClass(const vector<Point>& pts, const ComplexityClass& cls) {
+    double num = 0, den = 0;
+    for (const Point& p : pts) {
+        double f = cls.f(p.n);
+        num += f / p.seconds;
+        den += f * f / (p.seconds * p.seconds);
+    }
+    double c = num / den;
+    double err = 0;
+    for (const Point& p : pts) {
+        double r = (p.seconds - c * cls.f(p.n)) / p.seconds;
+        err += r * r;
+    }
+    return {&cls, c, sqrt(err / pts.size())};
+}
+
+vector<Fit> fitAll(const vector<Point>& pts) {
+    vector<Fit> fits;
+    for (const ComplexityClass& cls : classes) fits.push_back(fitClass(pts, cls));
+    sort(fits.begin(), fits.end(), [](const Fit& a, const Fit& b) { return a.rmsError < b.rmsError; });
+    return fits;
+}
+
+void report(const Algorithm& a, const vector<Point>& pts, const vector<Fit>& fits) {
+    printf("\n%s\n", a.name.c_str());
+    for (const Point& p : pts) printf("  n = %-9.0f %12.3f us\n", p.n, p.seconds * 1e6);
+    printf("  best fit: %-10s  time = %.3g * f(n) s, error %.1f%%\n", fits[0].cls->name, fits[0].c,
+           fits[0].rmsError * 100);
+    printf("  next:     %-10s  error %.1f%%\n", fits[1].cls->name, fits[1].rmsError * 100);
+}
+
+// n where c1 f1(n) and c2 f2(n) are equal (searched on a geometric grid),
+// 0 if the fast one is already below at n = 2, -1 if they never cross
+double modelCrossover(const Fit& slow, const Fit& fast) {
+    for (double n = 2; n < 1e15; n *= 1.02) {
+        double d = slow.c * slow.cls->f(n) - fast.c * fast.cls->f(n);
+        if (d >= 0) return n == 2 ? 0 : n;
+    }
+    return -1;
+}
+
+void fitAlone(const Algorithm& a) {
+    vector<Point> pts = measure(a);
+    report(a, pts, fitAll(pts));
+}
+
+void compare(const Algorithm& simple, const Algorithm& clever) {
+    vector<Point> ps = measure(simple), pc = measure(clever);
+    vector<Fit> fs = fitAll(ps), fc = fitAll(pc);
+    report(simple, ps, fs);
+    report(clever, pc, fc);
+
+    double measured = -1;
+    for (size_t i = 0; i < min(ps.size(), pc.size()); i++) {
+        if (pc[i].seconds < ps[i].seconds) { measured = ps[i].n; break; }
+    }
+    double model = modelCrossover(fs[0], fc[0]);
+    printf("  crossover: ");
+    if (model == 0) printf("the fitted %s curve is below from the start", clever.name.c_str());
+    else if (model < 0) printf("the fitted curves do not cross");
+    else printf("fitted curves cross at n ~ %.0f", model);
+    if (measured > 0) printf(", measured: \"%s\" wins from n = %.0f\n", clever.name.c_str(), measured);
+    else printf(", measured: \"%s\" never won in the measured range\n", clever.name.c_str());
+}
+
+// ---------------------------------------------------------------- algorithms
+
+vector<int> makeArray(size_t n) {
+    vector<int> v(n);
+    for (size_t i = 0; i < n; i++) v[i] = (int)((i * 2654435761u) % 1000) - 500;
+    return v;
+}
+
+// same walk as subarray_printng.cpp: rebuild every subarray from st
+long long subarraySumsTripleLoop(const vector<int>& arr) {
+    long long total = 0;
+    size_t n = arr.size();
+    for (size_t st = 0; st < n; st++)
+        for (size_t end = st; end < n; end++) {
+            long long sum = 0;
+            for (size_t i = st; i <= end; i++) sum += arr[i];
+            total ^= sum;
+        }
+    return total;
+}
+
+// incremental: [st..end] = [st..end-1] + arr[end]
+long long subarraySumsIncremental(const vector<int>& arr) {
+    long long total = 0;
+    size_t n = arr.size();
+    for (size_t st = 0; st < n; st++) {
+        long long sum = 0;
+        for (size_t end = st; end < n; end++) {
+            sum += arr[end];
+            total ^= sum;
+        }
+    }
+    return total;
+}
+
+// like prime no check.cpp, divisors up to n / 2
+bool isPrime(int n) {
+    if (n <= 1) return false;
+    for (int i = 2; i <= n / 2; i++)
+        if (n % i == 0) return false;
+    return true;
+}
+int countPrimesTrial(int n) {
+    int c = 0;
+    for (int i = 2; i <= n; i++) c += isPrime(i);
+    return c;
+}
+int countPrimesSieve(int n) {
+    vector<char> composite(n + 1, 0);
+    int c = 0;
+    for (int i = 2; i <= n; i++) {
+        if (composite[i]) continue;
+        c++;
+        for (long long j = (long long)i * i; j <= n; j += i) composite[j] = 1;
+    }
+    return c;
+}
+
+// ================================================================ registered functions
+
+COMPLEXITY("subarray sums, 3 loops (subarray_printng.cpp)", 1 << 12, "subarray sums") {
+    auto v = make_shared<vector<int>>(makeArray(n));
+    return [v]() { DoNotOptimize(subarraySumsTripleLoop(*v)); };
+}
+
+COMPLEXITY("subarray sums, incremental generator", 1 << 14, "subarray sums") {
+    auto v = make_shared<vector<int>>(makeArray(n));
+    return [v]() { DoNotOptimize(subarraySumsIncremental(*v)); };
+}
+
+COMPLEXITY("count primes, trial division to n/2", 1 << 17, "count primes") {
+    return [n]() { DoNotOptimize(countPrimesTrial((int)n)); };
+}
+
+COMPLEXITY("count primes, sieve", 1 << 24, "count primes") {
+    return [n]() { DoNotOptimize(countPrimesSieve((int)n)); };
+}
+
+// known classes, to see that the fitter gets them right
+
+COMPLEXITY("sum formula n(n+1)/2 (expect O(1))", 1 << 20, "") {
+    return [n]() {
+        size_t m = n;
+        DoNotOptimize(m);
+        DoNotOptimize(m * (m + 1) / 2);
+    };
+}
+
+COMPLEXITY("binary search (expect O(log n))", 1 << 24, "") {
+    auto v = make_shared<vector<int>>(n);
+    for (size_t i = 0; i < n; i++) (*v)[i] = (int)(2 * i);
+    auto probe = make_shared<size_t>(0);
+    return [v, probe, n]() {
+        *probe = (*probe + 7919) % n; // different target every call
+        DoNotOptimize(binary_search(v->begin(), v->end(), (int)(2 * *probe + 1)));
+    };
+}
+
+COMPLEXITY("linear search, not found (expect O(n))", 1 << 22, "") {
+    auto v = make_shared<vector<int>>(makeArray(n));
+    return [v]() {
+        int target = 100000;
+        DoNotOptimize(target);
+        DoNotOptimize(find(v->begin(), v->end(), target));
+    };
+}
+
+COMPLEXITY("sort (expect O(n log n))", 1 << 20, "") {
+    auto base = make_shared<vector<int>>(n);
+    auto work = make_shared<vector<int>>(n);
+    for (size_t i = 0; i < n; i++) (*base)[i] = (int)((i * 48271u) % 2147483647u);
+    return [base, work]() {
+        *work = *base;
+        sort(work->begin(), work->end());
+        DoNotOptimize(work->data());
+    };
+}
+
+int main() {
+    printf("==== functions with a known class ====\n");
+    for (const Algorithm& a : registry()) {
+        if (a.group.empty()) fitAlone(a);
+    }
+
+    printf("\n==== simple vs clever ====\n");
+    const vector<Algorithm>& all = registry();
+    for (size_t i = 0; i < all.size(); i++) {
+        if (all[i].group.empty()) continue;
+        bool seenBefore = false; // the group was compared already at its first member
+        for (size_t k = 0; k < i; k++) seenBefore = seenBefore || all[k].group == all[i].group;
+        if (seenBefore) continue;
+        size_t j = i + 1;
+        while (j < all.size() && all[j].group != all[i].group) j++;
+        if (j < all.size()) compare(all[i], all[j]);
+        else fitAlone(all[i]); // nothing to compare with
+    }
+    return 0;
+}
+/*
+Things to keep in mind when reading the fits:
+- At small n the fixed cost of a call (function call, loop setup) dominates,
+  so everything looks a bit like O(1) there.
+- When the data stops fitting in the cache (a few MB) the constant jumps, so a
+  O(n) function can look a bit worse than O(n) at the largest sizes.
+- The counting of primes with trial division is about n^2 / log n, which is not
+  in the list; it lands between O(n log n) and O(n^2), usually on O(n^2).
+*/
@@ -0,0 +1,776 @@
+/*
+Time complexity in practice :- a small micro-benchmark harness.
+
+Measuring one call of a fast function with a stopwatch gives garbage: the clock
+itself costs ~20 ns, the first calls run with cold caches, and the compiler may
+delete a call whose result is never used. This harness handles that:
+
+1. DoNotOptimize(x) :- tells the compiler "x is used", so the work that
+   produces x cannot be removed or moved out of the timing loop.
+2. Warmup :- every benchmark runs for a while before measuring, so caches,
+   branch predictors and CPU frequency settle.
+3. Batching :- calls are timed in batches large enough (about 20 us) that the
+   clock cost does not matter. One batch = one sample = time / calls.
+4. Repetitions + robust statistics :- many samples, then
+       median  = middle sample (not disturbed by a few slow ones)
+       p99     = 99% of samples are faster than this
+       MAD     = median of |sample - median|, the "spread" that ignores outliers
+   Mean and standard deviation are printed too, but one interrupt can move them.
+5. Clock :- rdtsc (the CPU cycle counter, ~1 ns resolution, calibrated against
+   the OS clock at start) on x86, clock_gettime / steady_clock everywhere else.
+6. Hardware counters (Linux) :- the time says HOW slow, the CPU's own counters
+   say WHY. After the timing, every benchmark is run once more with counters for
+   cycles, instructions, L1 data cache misses, last level cache (LLC) misses,
+   branch misses and data TLB misses (opened with perf_event_open). Printed:
+       IPC          = instructions / cycles (about 4 is the best a core does,
+                      below 1 usually means it waits for memory)
+       misses/elem  = misses per call / elements one call works on
+   Inside containers and VMs the counters are often not allowed or not there;
+   then the missing ones show as "-" and the timing still works.
+7. JSON :- --json=file writes every result in a machine readable form.
+
+Every algorithm of the lecture folders is registered below (copied here because
+each lecture file is its own program with its own main).
+
+usage   :- time.exe [--filter=text] [--reps=N] [--json=out.json] [--no-counters]
+compile :- g++ -std=c++17 -O2 time.cpp
+*/
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <x86intrin.h>
+#define HAVE_RDTSC 1
+#endif
+#ifndef _WIN32
+#include <time.h>
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+using namespace std;
+
+// ---------------------------------------------------------------- barriers
+
+// the value must exist in a register or memory here, so the work that made it
+// cannot be skipped; "memory" also stops the compiler from caching memory
+template <class T>
+inline void DoNotOptimize(T const& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// everything written to memory before this point really gets written
+inline void ClobberMemory() {
+#if defined(__GNUC__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+// the compiler has to forget what it knows about value (it may have been
+// changed here), so a loop that uses it cannot be replaced by a formula
+template <class T>
+inline void Launder(T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : "+r,m"(value));
+#else
+    static volatile T copy;
+    copy = value;
+    value = copy;
+#endif
+}
+
+// ---------------------------------------------------------------- clock
+
+class Clock {
+public:
+    Clock() {
+#ifdef HAVE_RDTSC
+        // how many cycle counter ticks happen in one nanosecond
+        uint64_t c0 = __rdtsc();
+        uint64_t n0 = osNanos();
+        while (osNanos() - n0 < 20000000) {} // 20 ms
+        uint64_t c1 = __rdtsc();
+        uint64_t n1 = osNanos();
+        ticksPerNs = double(c1 - c0) / double(n1 - n0);
+#endif
+    }
+
+    // current time in ticks, and ticks -> nanoseconds
+    uint64_t now() const {
+#ifdef HAVE_RDTSC
+        return __rdtsc();
+#else
+        return osNanos();
+#endif
+    }
+    double toNs(uint64_t ticks) const { return ticks / ticksPerNs; }
+    const char* name() const {
+#ifdef HAVE_RDTSC
+        return "rdtsc";
+#elif !defined(_WIN32)
+        return "clock_gettime";
+#else
+        return "steady_clock";
+#endif
+    }
+
+    static uint64_t osNanos() {
+#ifndef _WIN32
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#else
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+private:
+    double ticksPerNs = 1.0;
+};
+
+// ---------------------------------------------------------------- hardware counters
+
+enum CounterId { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, DTLB_MISSES, NUM_COUNTERS };
+const char* counterNames[NUM_COUNTERS] = {"cycles", "instructions", "l1d_misses",
+                                          "llc_misses", "branch_misses", "dtlb_misses"};
+
+// counts per call, NAN where the counter could not be read
+struct CounterValues {
+    double v[NUM_COUNTERS] = {NAN, NAN, NAN, NAN, NAN, NAN};
+};
+
+// Two groups of three: a group is scheduled on the CPU all together or not at
+// all, so its counters are comparable with each other (IPC from one group).
+// Six at once often do not fit in the counter registers of a core. If the
+// kernel still has to share the registers (multiplexing), every group is
+// scaled by time_enabled / time_running.
+class PerfCounters {
+public:
+#ifdef __linux__
+    PerfCounters() {
+        const uint64_t cache = PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+        struct { CounterId id; uint32_t type; uint64_t config; } events[NUM_COUNTERS] = {
+            {CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {L1D_MISSES, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | cache},
+            {LLC_MISSES, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | cache},
+            {DTLB_MISSES, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | cache},
+        };
+        for (int i = 0; i < NUM_COUNTERS; i++) {
+            Group& g = groups[i / 3];
+            int fd = open(events[i].type, events[i].config, g.leader);
+            if (fd < 0) {
+                if (error.empty()) error = string(counterNames[events[i].id]) + ": " + strerror(errno);
+                continue;
+            }
+            if (g.leader < 0) g.leader = fd;
+            g.fds[g.count] = fd;
+            g.ids[g.count] = events[i].id;
+            g.count++;
+        }
+    }
+
+    ~PerfCounters() {
+        for (Group& g : groups)
+            for (int i = 0; i < g.count; i++) close(g.fds[i]);
+    }
+
+    bool available() const { return groups[0].count + groups[1].count > 0; }
+    // why some (or all) counters are missing, e.g. "cycles: No such file or directory"
+    const string& whyMissing() const { return error; }
+
+    // runs work() with the counters on, returns the counts divided by calls
+    CounterValues measure(const function<void()>& work, double calls) {
+        CounterValues out;
+        for (Group& g : groups)
+            if (g.count > 0) ioctl(g.leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        for (Group& g : groups)
+            if (g.count > 0) ioctl(g.leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        work();
+        for (Group& g : groups)
+            if (g.count > 0) ioctl(g.leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        for (Group& g : groups) {
+            if (g.count == 0) continue;
+            // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, value[nr]
+            uint64_t buf[3 + 3] = {};
+            if (read(g.leader, buf, sizeof(buf)) <= 0 || buf[2] == 0) continue;
+            double scale = double(buf[1]) / double(buf[2]);
+            for (uint64_t i = 0; i < buf[0] && i < (uint64_t)g.count; i++)
+                out.v[g.ids[i]] = buf[3 + i] * scale / calls;
+        }
+        return out;
+    }
+
+private:
+    struct Group {
+        int leader = -1;
+        int fds[3];
+        CounterId ids[3];
+        int count = 0;
+    };
+    Group groups[2];
+    string error;
+
+    static int open(uint32_t type, uint64_t config, int leader) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = leader < 0;   // only the leader starts disabled, members follow it
+        attr.exclude_kernel = 1;      // user space only: allowed with perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+    }
+#else
+    bool available() const { return false; }
+    const string& whyMissing() const { return error; }
+    CounterValues measure(const function<void()>& work, double) {
+        work();
+        return CounterValues();
+    }
+
+private:
+    string error = "perf_event_open is Linux only";
+#endif
+};
+
+// ---------------------------------------------------------------- registry
+
+// body(iterations) must run the measured code exactly `iterations` times;
+// elements = how many array elements one call works on (for misses per element)
+struct Benchmark {
+    string name;
+    function<void(size_t)> body;
+    size_t elements;
+};
+
+vector<Benchmark>& registry() {
+    static vector<Benchmark> all;
+    return all;
+}
+
+struct Registrar {
+    Registrar(const string& name, function<void(size_t)> body, size_t elements = 1) {
+        registry().push_back({name, move(body), elements});
+    }
+};
+
+// BENCHMARK("name") { ... code using `iterations` ... }
+// BENCHMARK_ELEMENTS("name", 1000) { ... }  when one call walks 1000 elements
+#define BENCH_CONCAT2(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT2(a, b)
+#define BENCHMARK_ELEMENTS(name, elements)                                               \
+    static void BENCH_CONCAT(benchFn_, __LINE__)(size_t iterations);                     \
+    static Registrar BENCH_CONCAT(benchReg_, __LINE__)(name, BENCH_CONCAT(benchFn_, __LINE__), elements); \
+    static void BENCH_CONCAT(benchFn_, __LINE__)(size_t iterations)
+#define BENCHMARK(name) BENCHMARK_ELEMENTS(name, 1)
+
+// ---------------------------------------------------------------- statistics
+
+struct Result {
+    string name;
+    size_t batch = 0, samples = 0, elements = 1;
+    double minNs = 0, medianNs = 0, meanNs = 0, stddevNs = 0, p99Ns = 0, madNs = 0, maxNs = 0;
+    CounterValues counters; // per call
+
+    // NaN (= "not known") when no cycles were counted, instead of inf or 0/0
+    double ipc() const {
+        double cycles = counters.v[CYCLES];
+        return cycles > 0 ? counters.v[INSTRUCTIONS] / cycles : NAN;
+    }
+    double perElement(CounterId id) const { return counters.v[id] / elements; }
+};
+
+double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    double pos = p * (sorted.size() - 1);
+    size_t lo = (size_t)pos;
+    size_t hi = min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (pos - lo) * (sorted[hi] - sorted[lo]);
+}
+
+Result summarize(const string& name, size_t batch, vector<double> ns) {
+    Result r;
+    r.name = name;
+    r.batch = batch;
+    r.samples = ns.size();
+    sort(ns.begin(), ns.end());
+    r.minNs = ns.front();
+    r.maxNs = ns.back();
+    r.medianNs = percentile(ns, 0.5);
+    r.p99Ns = percentile(ns, 0.99);
+    double sum = 0;
+    for (double x : ns) sum += x;
+    r.meanNs = sum / ns.size();
+    double var = 0;
+    for (double x : ns) var += (x - r.meanNs) * (x - r.meanNs);
+    r.stddevNs = ns.size() > 1 ? sqrt(var / (ns.size() - 1)) : 0;
+    vector<double> dev;
+    for (double x : ns) dev.push_back(fabs(x - r.medianNs));
+    sort(dev.begin(), dev.end());
+    r.madNs = percentile(dev, 0.5);
+    return r;
+}
+
+// ---------------------------------------------------------------- runner
+
+struct Options {
+    string filter;
+    string jsonPath;
+    size_t repetitions = 101;
+    double warmupMs = 50;
+    double sampleTargetNs = 20000; // one sample should take about 20 us
+    bool counters = true;
+    size_t counterBatches = 10;    // batches run with the counters on
+};
+
+Result runBenchmark(const Benchmark& b, const Clock& clock, PerfCounters* perf, const Options& opt) {
+    // warmup: call it until warmupMs have passed
+    uint64_t startNs = Clock::osNanos();
+    size_t batch = 1;
+    while (Clock::osNanos() - startNs < opt.warmupMs * 1e6) b.body(batch);
+
+    // find a batch size that takes about sampleTargetNs
+    for (batch = 1;; batch *= 2) {
+        uint64_t t0 = clock.now();
+        b.body(batch);
+        uint64_t t1 = clock.now();
+        if (clock.toNs(t1 - t0) >= opt.sampleTargetNs || batch >= (1u << 30)) break;
+    }
+
+    vector<double> perCall;
+    perCall.reserve(opt.repetitions);
+    for (size_t rep = 0; rep < opt.repetitions; rep++) {
+        uint64_t t0 = clock.now();
+        b.body(batch);
+        uint64_t t1 = clock.now();
+        perCall.push_back(clock.toNs(t1 - t0) / batch);
+    }
+    Result r = summarize(b.name, batch, perCall);
+    r.elements = b.elements;
+
+    // a separate run for the counters, so opening / reading them is not in the times
+    if (perf != nullptr) {
+        size_t batches = opt.counterBatches;
+        r.counters = perf->measure([&]() {
+            for (size_t i = 0; i < batches; i++) b.body(batch);
+        }, double(batch) * batches);
+    }
+    return r;
+}
+
+string jsonEscape(const string& s) {
+    string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void writeJson(ostream& out, const vector<Result>& results, const Clock& clock, const Options& opt) {
+    out << "{\n  \"clock\": \"" << clock.name() << "\",\n  \"repetitions\": " << opt.repetitions
+        << ",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"batch\": " << r.batch
+            << ", \"samples\": " << r.samples << ", \"min_ns\": " << r.minNs
+            << ", \"median_ns\": " << r.medianNs << ", \"mean_ns\": " << r.meanNs
+            << ", \"stddev_ns\": " << r.stddevNs << ", \"p99_ns\": " << r.p99Ns
+            << ", \"mad_ns\": " << r.madNs << ", \"max_ns\": " << r.maxNs
+            << ", \"elements\": " << r.elements;
+        // counters that could not be read are left out (JSON has no NaN or inf)
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+            if (isfinite(r.counters.v[c])) out << ", \"" << counterNames[c] << "\": " << r.counters.v[c];
+        }
+        if (isfinite(r.ipc())) out << ", \"ipc\": " << r.ipc();
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// ================================================================ lecture code
+
+// lecture no 3 loops/prime no check.cpp
+bool isPrime(int n) {
+    if (n <= 1) return false;
+    for (int i = 2; i <= n / 2; i++) {
+        if (n % i == 0) return false;
+    }
+    return true;
+}
+
+// lecture no 3 loops/sum of odd , even no.cpp
+pair<int, int> sumOddEven(int a) {
+    int sum = 0, oddsum = 0;
+    for (int i = 0; i <= a; i++) {
+        if (i % 2 == 0) sum += i;
+        else oddsum += i;
+    }
+    return {sum, oddsum};
+}
+
+// lecture no 3 loops/checking letter uppercase.cpp
+bool isUppercase(char ch) { return ch >= 'A' && ch <= 'Z'; }
+
+// lecture no 5 functions/binomial coefficient calculation .cpp
+int factorial(int n) {
+    int fact = 1;
+    for (int i = 1; i <= n; i++) fact *= i;
+    return fact;
+}
+int nCr(int n, int r) {
+    if (r > n) return 0;
+    return factorial(n) / (factorial(r) * factorial(n - r));
+}
+
+// lecture no 5 functions/factorial calculation .cpp (there the function is called sum)
+long factorialLong(int n) {
+    long f = 1;
+    for (long i = 1; i <= n; i++) f *= i;
+    return f;
+}
+
+// lecture no 5 functions/sum of digits of a number .cpp
+int sumOfDigits(int num) {
+    int digSum = 0;
+    for (; num > 0; num /= 10) digSum += num % 10;
+    return digSum;
+}
+
+// lecture no 5 functions/sum of n natural no. .cpp
+int sumFormula(int n) { return n * (n + 1) / 2; }
+int sumLoop(int n) {
+    int s = 0;
+    for (int i = 0; i <= n; i++) {
+        Launder(i); // without it g++ -O2 turns the loop into n(n+1)/2 by itself
+        s += i;
+    }
+    return s;
+}
+
+// lecture no 6 binary no system
+int decToBinary(int decNum) {
+    int ans = 0, pow = 1;
+    while (decNum > 0) {
+        ans += (decNum % 2) * pow;
+        decNum /= 2;
+        pow *= 10;
+    }
+    return ans;
+}
+int binaryToDecimal(int binaryNum) {
+    int ans = 0, pow = 1;
+    while (binaryNum > 0) {
+        ans += (binaryNum % 10) * pow;
+        pow *= 2;
+        binaryNum /= 10;
+    }
+    return ans;
+}
+
+// lecture no 8 Arry
+void reverseArray(int arr[], int size) {
+    int left = 0, right = size - 1;
+    while (left < right) {
+        int temp = arr[left];
+        arr[left++] = arr[right];
+        arr[right--] = temp;
+    }
+}
+int linearSearch(int arr[], int sz, int target) {
+    for (int i = 0; i < sz; i++) {
+        if (arr[i] == target) return i;
+    }
+    return -1;
+}
+pair<int, int> findMaxMin(const int arr[], int size) {
+    int largest = INT_MIN, smallest = INT_MAX;
+    for (int i = 0; i < size; i++) {
+        largest = max(arr[i], largest);
+        smallest = min(arr[i], smallest);
+    }
+    return {largest, smallest};
+}
+
+// lecture no 9 vectors/single number problem .cpp
+int singleNumber(const vector<int>& nums) {
+    int result = 0;
+    for (int num : nums) result ^= num;
+    return result;
+}
+
+// lecture no 10 array questions/maximum subarray sum .cpp (Kadane)
+long long maxSubarraySum(const vector<int>& arr) {
+    long long best = arr[0], current = 0;
+    for (int x : arr) {
+        current = max(current + x, (long long)x);
+        best = max(best, current);
+    }
+    return best;
+}
+
+// lecture no 10 array questions/subarray_printng.cpp, printing into a string
+void printSubarrays(const vector<int>& arr, string& out) {
+    size_t n = arr.size();
+    for (size_t st = 0; st < n; st++) {
+        for (size_t end = st; end < n; end++) {
+            for (size_t i = st; i <= end; i++) out += char('0' + arr[i] % 10);
+            out += ' ';
+        }
+        out += '\n';
+    }
+}
+
+// ================================================================ registered benchmarks
+
+vector<int> makeArray(size_t n) {
+    vector<int> v(n);
+    for (size_t i = 0; i < n; i++) v[i] = (int)((i * 2654435761u) % 1000) - 500;
+    return v;
+}
+
+BENCHMARK("isPrime(1000003)") {
+    int n = 1000003;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(n);
+        DoNotOptimize(isPrime(n));
+    }
+}
+
+BENCHMARK("sumOddEven(1000)") {
+    int a = 1000;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(a);
+        DoNotOptimize(sumOddEven(a));
+    }
+}
+
+BENCHMARK("isUppercase") {
+    char ch = 'Q';
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(ch);
+        DoNotOptimize(isUppercase(ch));
+    }
+}
+
+BENCHMARK("nCr(12, 5)") {
+    int n = 12, r = 5;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(n);
+        DoNotOptimize(r);
+        DoNotOptimize(nCr(n, r));
+    }
+}
+
+BENCHMARK("factorial(20)") {
+    int n = 20;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(n);
+        DoNotOptimize(factorialLong(n));
+    }
+}
+
+BENCHMARK("sumOfDigits(2147483647)") {
+    int n = 2147483647;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(n);
+        DoNotOptimize(sumOfDigits(n));
+    }
+}
+
+BENCHMARK("sum of n natural, formula") {
+    int n = 10000;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(n);
+        DoNotOptimize(sumFormula(n));
+    }
+}
+
+// O(n): the time per call should grow 10x from one size to the next
+BENCHMARK_ELEMENTS("sum of n natural, loop, n = 1000", 1000) {
+    int n = 1000;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(n);
+        DoNotOptimize(sumLoop(n));
+    }
+}
+
+BENCHMARK_ELEMENTS("sum of n natural, loop, n = 10000", 10000) {
+    int n = 10000;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(n);
+        DoNotOptimize(sumLoop(n));
+    }
+}
+
+BENCHMARK("decToBinary(1023)") {
+    int n = 1023;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(n);
+        DoNotOptimize(decToBinary(n));
+    }
+}
+
+BENCHMARK("binaryToDecimal(1111111111)") {
+    int n = 1111111111;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(n);
+        DoNotOptimize(binaryToDecimal(n));
+    }
+}
+
+BENCHMARK_ELEMENTS("reverseArray(1000)", 1000) {
+    static vector<int> v = makeArray(1000); // built once, not inside the timing
+    for (size_t i = 0; i < iterations; i++) {
+        reverseArray(v.data(), (int)v.size());
+        ClobberMemory();
+    }
+    DoNotOptimize(v[0]);
+}
+
+BENCHMARK_ELEMENTS("linearSearch(1000), not found", 1000) {
+    static vector<int> v = makeArray(1000); // built once, not inside the timing
+    int target = 100000;
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(target);
+        DoNotOptimize(linearSearch(v.data(), (int)v.size(), target));
+    }
+}
+
+BENCHMARK_ELEMENTS("findMaxMin(1000)", 1000) {
+    static vector<int> v = makeArray(1000); // built once, not inside the timing
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(v.data());
+        DoNotOptimize(findMaxMin(v.data(), (int)v.size()));
+    }
+}
+
+BENCHMARK_ELEMENTS("singleNumber(1001)", 1001) {
+    static vector<int> v = makeArray(1001); // built once, not inside the timing
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(v.data());
+        DoNotOptimize(singleNumber(v));
+    }
+}
+
+BENCHMARK_ELEMENTS("maxSubarraySum(1000)", 1000) {
+    static vector<int> v = makeArray(1000); // built once, not inside the timing
+    for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(v.data());
+        DoNotOptimize(maxSubarraySum(v));
+    }
+}
+
+BENCHMARK_ELEMENTS("printSubarrays(20)", 20) {
+    static vector<int> v = makeArray(20); // built once, not inside the timing
+    static string out;
+    for (size_t i = 0; i < iterations; i++) {
+        out.clear();
+        printSubarrays(v, out);
+        DoNotOptimize(out.data());
+    }
+}
+
+// ================================================================ main
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        string a = argv[i];
+        if (a.rfind("--filter=", 0) == 0) opt.filter = a.substr(9);
+        else if (a.rfind("--json=", 0) == 0) opt.jsonPath = a.substr(7);
+        else if (a.rfind("--reps=", 0) == 0) opt.repetitions = max(1, stoi(a.substr(7)));
+        else if (a == "--no-counters") opt.counters = false;
+        else {
+            cout << "usage: " << argv[0] << " [--filter=text] [--reps=N] [--json=out.json] [--no-counters]" << endl;
+            return 1;
+        }
+    }
+
+    Clock clock;
+    PerfCounters perf;
+    PerfCounters* usePerf = opt.counters && perf.available() ? &perf : nullptr;
+    cout << "clock: " << clock.name() << ", repetitions: " << opt.repetitions << "\n";
+    if (!opt.counters) cout << "hardware counters: off\n";
+    else if (!perf.available()) cout << "hardware counters: not available (" << perf.whyMissing() << ")\n";
+    else if (!perf.whyMissing().empty()) cout << "hardware counters: some missing (" << perf.whyMissing() << ")\n";
+    cout << "\nbenchmark                          median ns      p99 ns      MAD ns       batch\n";
+
+    vector<Result> results;
+    for (const Benchmark& b : registry()) {
+        if (!opt.filter.empty() && b.name.find(opt.filter) == string::npos) continue;
+        Result r = runBenchmark(b, clock, usePerf, opt);
+        results.push_back(r);
+        char line[200];
+        snprintf(line, sizeof(line), "%-32s %12.2f %11.2f %11.2f %11zu", r.name.c_str(), r.medianNs,
+                 r.p99Ns, r.madNs, r.batch);
+        cout << line << "\n";
+    }
+
+    if (usePerf != nullptr) {
+        // per call: cycles; per element: the misses ("-" = counter not readable)
+        cout << "\nbenchmark                           cycles    IPC  L1D miss   LLC miss  br. miss  dTLB miss\n"
+             << "                                  per call         per elem   per elem  per elem   per elem\n";
+        for (const Result& r : results) {
+            auto cell = [](double x, const char* fmt) {
+                char buf[32];
+                if (!isfinite(x)) snprintf(buf, sizeof(buf), "%s", "-");
+                else snprintf(buf, sizeof(buf), fmt, x);
+                return string(buf);
+            };
+            char line[200];
+            snprintf(line, sizeof(line), "%-32s %9s %6s %9s %10s %9s %10s", r.name.c_str(),
+                     cell(r.counters.v[CYCLES], "%.0f").c_str(), cell(r.ipc(), "%.2f").c_str(),
+                     cell(r.perElement(L1D_MISSES), "%.4f").c_str(), cell(r.perElement(LLC_MISSES), "%.4f").c_str(),
+                     cell(r.perElement(BRANCH_MISSES), "%.4f").c_str(), cell(r.perElement(DTLB_MISSES), "%.4f").c_str());
+            cout << line << "\n";
+        }
+    }
+
+    if (!opt.jsonPath.empty()) {
+        ofstream out(opt.jsonPath);
+        writeJson(out, results, clock, opt);
+        cout << "\nJSON written to " << opt.jsonPath << endl;
+    }
+    return 0;
+}
+/*
+Reading the numbers :-
+- If MAD is small compared to the median, the result is stable.
+- If p99 is far above the median, something (interrupts, other programs,
+  frequency changes) disturbed some samples; the median is still trustworthy.
+- isPrime loops up to n / 2, so for a prime n it does n / 2 divisions; compare
+  with sumOfDigits which only does about 10 (one per digit): O(n) vs O(log n).
+- IPC near 3-4 with almost no misses (findMaxMin, singleNumber): the loop is
+  limited by the core itself. Low IPC with many cache misses per element: it
+  waits for memory, a faster loop body will not help, better data layout will.
+- Branch misses per element near 0.5 mean the branch is a coin flip for the
+  predictor (data dependent ifs on random data); near 0 it is predicted well.
+- "not available" in docker / VMs :- the kernel must allow it
+  (/proc/sys/kernel/perf_event_paranoid <= 2 for user space counting, and docker
+  blocks perf_event_open in its default seccomp profile) and the VM must expose
+  the CPU's counters. The timing part does not need any of that.
+*/
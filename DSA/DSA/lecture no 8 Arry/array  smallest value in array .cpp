@@ -3,12 +3,13 @@ using namespace std;
 
 int main() {
    int next[] = {32, 1, 32, 0, -1, -23, 2};
-   int start = 5;
+   int start = sizeof(next) / sizeof(next[0]); // all 7 elements, not only the first 5
    int smallest = __INT_MAX__;
 
    for (int i = 0; i< start ; i++){
    //smallest = min (next[i],smallest);it can be used instead of if
      if (next[i] < smallest){
+       smallest = next[i];
        /*
        logic behind __INT_MAX__: is to assign infinity value 
        to the smallest variable , condition is next[i] < smallest
@@ -17,7 +18,8 @@ int main() {
        smallest = next[i]; means smallest will be the value of 
        next[i] and this value compare to the other and if the 
        smallest variable is lesser than to the next[i] varible
-       then the smallest variable will be same because if condition false */
+       then the smallest variable will be same because if condition false
+       for the k smallest values instead of only one see "top k smallest values .cpp" */
      }
    }cout << smallest<< endl;
 }
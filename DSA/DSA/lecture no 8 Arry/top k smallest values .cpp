@@ -0,0 +1,198 @@
+/*
+Top-k selection :- find the k smallest (or k largest) values of a stream.
+
+"array  smallest value in array .cpp" keeps ONE minimum. Here we keep the k best
+values seen so far, and the numbers can keep coming forever (a stream), so we
+never store the whole input.
+
+Three ways are shown:
+1. Bounded heap   :- a max-heap of size k. Its top is the WORST of the k best,
+                     which we call the threshold. A new value only enters if it
+                     beats the threshold, then the old top is thrown away.
+2. SIMD filter    :- once the heap is full, almost every new value is worse than
+                     the threshold. We compare 8 ints at once against it and skip
+                     the whole block when none of them can enter the heap.
+3. nth_element    :- when the whole batch is already in memory, nth_element puts
+                     the k smallest in front in O(n) on average, then we sort only
+                     those k.
+
+Every thread can fill its own TopK and the results are merged at the end,
+because the k best of (A + B) are always inside (k best of A) + (k best of B).
+
+compile :- g++ -std=c++17 -O2 -march=native -pthread "top k smallest values .cpp"
+(without -march=native the scalar loop is used instead of AVX2)
+*/
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <chrono>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+class TopK {
+public:
+    // largest = false -> keep k smallest, largest = true -> keep k largest
+    TopK(size_t k, bool largest = false) : k(k), largest(largest) {
+        heap.reserve(k);
+    }
+
+    // push one value of the stream
+    void push(int x) {
+        if (k == 0) return;
+        if (heap.size() < k) {
+            heap.push_back(x);
+            push_heap(heap.begin(), heap.end(), cmp());
+            return;
+        }
+        if (better(x, heap.front())) {
+            // replace the worst of the k best with x
+            pop_heap(heap.begin(), heap.end(), cmp());
+            heap.back() = x;
+            push_heap(heap.begin(), heap.end(), cmp());
+        }
+    }
+
+    // push a whole block of the stream, skipping values that cannot enter
+    void push(const int* a, size_t n) {
+        size_t i = 0;
+        // fill the heap first, until we have a threshold to compare against
+        while (i < n && heap.size() < k) push(a[i++]);
+        if (k == 0) return;
+#ifdef __AVX2__
+        for (; i + 8 <= n; i += 8) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(a + i));
+            __m256i t = _mm256_set1_epi32(heap.front());
+            // lanes that beat the threshold become all 1 bits
+            __m256i hit = largest ? _mm256_cmpgt_epi32(v, t) : _mm256_cmpgt_epi32(t, v);
+            if (_mm256_testz_si256(hit, hit)) continue; // nothing useful in these 8
+            for (size_t j = i; j < i + 8; j++) push(a[j]);
+        }
+#endif
+        for (; i < n; i++) {
+            if (better(a[i], heap.front())) push(a[i]);
+        }
+    }
+
+    // add the result of another TopK (for example from another thread)
+    void merge(const TopK& other) {
+        push(other.heap.data(), other.heap.size());
+    }
+
+    // the k best values, best first
+    vector<int> result() const {
+        vector<int> out = heap;
+        sort(out.begin(), out.end(), cmp());
+        return out;
+    }
+
+    size_t size() const { return heap.size(); }
+
+private:
+    size_t k;
+    bool largest;
+    vector<int> heap; // top (front) is the threshold
+
+    bool better(int x, int y) const { return largest ? x > y : x < y; }
+    // comparator that puts the worst kept value on top of the heap
+    struct Cmp {
+        bool largest;
+        bool operator()(int x, int y) const { return largest ? x > y : x < y; }
+    };
+    Cmp cmp() const { return Cmp{largest}; }
+};
+
+// batch path: the whole array is in memory already
+vector<int> topKBatch(vector<int> data, size_t k, bool largest = false) {
+    k = min(k, data.size());
+    auto cmp = [largest](int x, int y) { return largest ? x > y : x < y; };
+    nth_element(data.begin(), data.begin() + k, data.end(), cmp);
+    data.resize(k);
+    sort(data.begin(), data.end(), cmp);
+    return data;
+}
+
+// each thread fills its own TopK on one chunk, then all of them are merged
+vector<int> topKParallel(const vector<int>& data, size_t k, bool largest, unsigned threads) {
+    vector<TopK> partial(threads, TopK(k, largest));
+    vector<thread> pool;
+    size_t chunk = (data.size() + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            size_t begin = min(data.size(), t * chunk);
+            size_t end = min(data.size(), begin + chunk);
+            partial[t].push(data.data() + begin, end - begin);
+        });
+    }
+    for (auto& th : pool) th.join();
+    for (unsigned t = 1; t < threads; t++) partial[0].merge(partial[t]);
+    return partial[0].result();
+}
+
+template <class F>
+double timeMs(F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    // same array as "array  smallest value in array .cpp"
+    int next[] = {32, 1, 32, 0, -1, -23, 2};
+    int size = sizeof(next) / sizeof(next[0]);
+
+    TopK small3(3), large3(3, true);
+    small3.push(next, size);
+    large3.push(next, size);
+    cout << "3 smallest: ";
+    for (int x : small3.result()) cout << x << " ";
+    cout << "\n3 largest: ";
+    for (int x : large3.result()) cout << x << " ";
+    cout << "\n\n";
+
+    // benchmark on a big random stream
+    size_t n = argc > 1 ? stoul(argv[1]) : 20000000;
+    size_t k = 100;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    vector<int> data(n);
+    mt19937 rng(42);
+    for (auto& x : data) x = (int)rng();
+
+    vector<int> a, b, c, d;
+    double tHeap = timeMs([&]() {
+        TopK t(k);
+        t.push(data.data(), data.size());
+        a = t.result();
+    });
+    double tPar = timeMs([&]() { b = topKParallel(data, k, false, threads); });
+    double tNth = timeMs([&]() { c = topKBatch(data, k); });
+    double tSort = timeMs([&]() {
+        vector<int> copy = data;
+        sort(copy.begin(), copy.end());
+        copy.resize(k);
+        d = copy;
+    });
+
+    cout << "n = " << n << ", k = " << k << "\n";
+    cout << "heap + filter      : " << tHeap << " ms\n";
+    cout << "parallel (" << threads << " thr)   : " << tPar << " ms\n";
+    cout << "nth_element batch  : " << tNth << " ms\n";
+    cout << "full sort          : " << tSort << " ms\n";
+    cout << (a == d && b == d && c == d ? "all results match" : "MISMATCH") << endl;
+    return 0;
+}
+/*
+Why the filter helps :- after the first few thousand values the threshold is
+already very small (for k smallest), so the chance that a random value beats it
+is about k / i. Almost every block of 8 fails the compare and is skipped with a
+single instruction, so the heap is touched only a few hundred times.
+
+| method        | time            | extra memory |
+| ------------- | --------------- | ------------ |
+| bounded heap  | O(n log k)      | O(k)         |
+| nth_element   | O(n + k log k)  | O(n) copy    |
+| full sort     | O(n log n)      | O(n) copy    |
+*/
@@ -0,0 +1,339 @@
+/*
+Allocation tracker :- see every heap allocation a program makes, grouped by the
+place in the code that asked for it (the call site).
+
+Questions it answers:
+- how many times did push_back reallocate in "size and capacity of vector
+  checking .cpp"? (one allocation per growth step from the same call site)
+- how many strings did the copies in "Copy Constructor.cpp" allocate?
+- what was the most memory alive at the same time (peak)?
+
+How it works :- this file replaces the global operator new / delete. Every
+allocation gets a small hidden header with its size, so delete knows how many
+bytes are freed and the live / peak numbers stay exact. Per call site counts are
+first written into a table that belongs to the current thread (no lock, no
+heap), and merged into the global table when the thread ends. When the program
+exits, a report is printed to stderr.
+
+Which call site :- the direct caller of operator new is very often a function
+inside the standard library (vector's grow step, string's copy), so all vectors
+would land on one line. The tracker walks up to 8 frames of the call stack
+(backtrace) and charges the first frame that is not in std:: / __gnu_cxx:: or
+operator new itself: that is the line of YOUR code. Whether a frame is library
+code is decided from its symbol name (dladdr) and remembered per address, so it
+is looked up only once. Walking the stack makes every allocation slower; this
+is a tool to look at a program, not to leave in.
+
+It is opt-in :- nothing changes unless this file is compiled together with the
+program you want to look at:
+    g++ -std=c++17 -O2 -rdynamic "size and capacity of vector checking .cpp" "allocation tracker .cpp"
+    g++ -std=c++17 -O2 -rdynamic "../OOPs lecture/Constructors/Copy Constructor.cpp" "allocation tracker .cpp"
+(-rdynamic lets the report print function names instead of only addresses, and
+lets the tracker recognise std:: functions that were compiled into the program.)
+For a quick look on its own: g++ -std=c++17 -DALLOCATION_TRACKER_DEMO "allocation tracker .cpp"
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <atomic>
+#include <mutex>
+#ifdef __linux__
+#include <dlfcn.h>
+#include <cxxabi.h>
+#include <execinfo.h>
+#endif
+
+namespace {
+
+struct SiteStats {
+    void* site = nullptr;
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0;
+    uint64_t smallest = UINT64_MAX;
+    uint64_t largest = 0;
+};
+
+// fixed size open addressing table: recording never allocates memory itself
+const size_t kSites = 4096;
+
+struct SiteTable {
+    SiteStats slots[kSites];
+
+    SiteStats* find(void* site) {
+        size_t h = ((uintptr_t)site >> 4) * 11400714819323198485ull >> 52; // 12 bits
+        for (size_t i = 0; i < kSites; i++) {
+            SiteStats& s = slots[(h + i) % kSites];
+            if (s.site == site) return &s;
+            if (s.site == nullptr) { s.site = site; return &s; }
+        }
+        return nullptr; // table full, the event is only counted in the totals
+    }
+
+    void mergeInto(SiteTable& global) {
+        for (SiteStats& s : slots) {
+            if (s.site == nullptr) continue;
+            SiteStats* g = global.find(s.site);
+            if (g != nullptr) {
+                g->allocations += s.allocations;
+                g->frees += s.frees;
+                g->bytes += s.bytes;
+                if (s.smallest < g->smallest) g->smallest = s.smallest;
+                if (s.largest > g->largest) g->largest = s.largest;
+            }
+            s = SiteStats();
+        }
+    }
+};
+
+SiteTable globalTable;
+std::mutex globalLock;
+std::atomic<int64_t> liveBytes{0}, peakBytes{0};
+std::atomic<uint64_t> totalAllocations{0}, totalFrees{0};
+
+// set when this thread's ThreadTable is destroyed; a plain bool outside the
+// object, so it can still be read after that (the Reporter and late frees)
+thread_local bool threadTableEnded = false;
+
+// every thread records into its own table, merged when the thread exits
+struct ThreadTable {
+    SiteTable* table = nullptr;
+    bool busy = false; // true while we are inside the tracker (no recursion)
+
+    ~ThreadTable() {
+        flush();
+        if (table != nullptr) {
+            table->~SiteTable();
+            std::free(table); // the tracker must not leak its own tables
+        }
+        threadTableEnded = true; // later events only go to the totals
+    }
+
+    SiteTable* get() {
+        if (table == nullptr && !threadTableEnded) {
+            void* mem = std::malloc(sizeof(SiteTable));
+            if (mem != nullptr) table = new (mem) SiteTable();
+        }
+        return threadTableEnded ? nullptr : table;
+    }
+
+    void flush() {
+        if (table == nullptr || threadTableEnded) return;
+        std::lock_guard<std::mutex> guard(globalLock);
+        table->mergeInto(globalTable);
+    }
+};
+thread_local ThreadTable threadTable;
+
+// the header in front of every block, 16 bytes so the user pointer stays aligned
+struct alignas(16) Header {
+    uint64_t size;
+    void* site;
+};
+
+void* trackedAlloc(size_t size, void* site) {
+    if (size > SIZE_MAX - sizeof(Header)) return nullptr; // header + size would wrap around
+    Header* h = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+    if (h == nullptr) return nullptr;
+    h->size = size;
+    h->site = site;
+
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    int64_t live = liveBytes.fetch_add((int64_t)size, std::memory_order_relaxed) + (int64_t)size;
+    int64_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+    if (!threadTable.busy) {
+        threadTable.busy = true;
+        if (SiteTable* t = threadTable.get()) {
+            if (SiteStats* s = t->find(site)) {
+                s->allocations++;
+                s->bytes += size;
+                if (size < s->smallest) s->smallest = size;
+                if (size > s->largest) s->largest = size;
+            }
+        }
+        threadTable.busy = false;
+    }
+    return h + 1;
+}
+
+void trackedFree(void* p) {
+    if (p == nullptr) return;
+    Header* h = static_cast<Header*>(p) - 1;
+    totalFrees.fetch_add(1, std::memory_order_relaxed);
+    liveBytes.fetch_sub((int64_t)h->size, std::memory_order_relaxed);
+    if (!threadTable.busy) {
+        threadTable.busy = true;
+        if (SiteTable* t = threadTable.get()) {
+            if (SiteStats* s = t->find(h->site)) s->frees++;
+        }
+        threadTable.busy = false;
+    }
+    std::free(h);
+}
+
+void printSite(void* site) {
+#ifdef __linux__
+    Dl_info info;
+    if (dladdr(site, &info) && info.dli_sname != nullptr) {
+        int status = 0;
+        char* nice = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        const char* name = status == 0 ? nice : info.dli_sname;
+        std::fprintf(stderr, "  %p  %.90s+%#lx\n", site, name,
+                     (unsigned long)((char*)site - (char*)info.dli_saddr));
+        std::free(nice);
+        return;
+    }
+#endif
+    std::fprintf(stderr, "  %p  (use addr2line -f -C -e <program> %p)\n", site, site);
+}
+
+#ifdef __linux__
+// true for frames of the standard library (and of operator new): their mangled
+// names start with std:: (St, Sa = std::allocator, Ss = std::string) or __gnu_cxx.
+// The mangled name is checked, because a demangled name can start with a return type.
+bool isLibraryFrame(void* pc) {
+    Dl_info info;
+    if (!dladdr(pc, &info) || info.dli_sname == nullptr) return false; // no name known: count it as ours
+    static const char* const prefixes[] = {"_ZSt",  "_ZNSt", "_ZNKSt", "_ZNSa", "_ZNKSa", "_ZNSs", "_ZNKSs",
+                                           "_ZN9__gnu_cxx", "_ZNK9__gnu_cxx", "_Znw", "_Zna"};
+    for (const char* prefix : prefixes) {
+        if (std::strncmp(info.dli_sname, prefix, std::strlen(prefix)) == 0) return true;
+    }
+    return false;
+}
+
+// answers of isLibraryFrame for this thread, one slot per address (a newer
+// address simply replaces an older one in the same slot)
+struct FrameKind {
+    void* pc;
+    bool library;
+};
+thread_local FrameKind frameKinds[1024];
+
+bool isLibraryFrameCached(void* pc) {
+    FrameKind& k = frameKinds[((uintptr_t)pc >> 2) % 1024];
+    if (k.pc != pc) k = {pc, isLibraryFrame(pc)};
+    return k.library;
+}
+#endif
+
+// the call site to charge: the first frame above operator new that is not
+// standard library code. caller is operator new's own return address, used
+// as it is when the stack cannot be walked.
+void* callSite(void* caller) {
+#ifdef __linux__
+    if (threadTable.busy) return caller; // an allocation made by backtrace / dladdr themselves
+    threadTable.busy = true;
+    void* frames[8];
+    int depth = backtrace(frames, 8);
+    int first = 0;
+    while (first < depth && frames[first] != caller) first++; // skip the tracker's own frames
+    void* site = caller;
+    for (int i = first; i < depth; i++) {
+        if (!isLibraryFrameCached(frames[i])) {
+            site = frames[i];
+            break;
+        }
+    }
+    threadTable.busy = false;
+    return site;
+#else
+    return caller;
+#endif
+}
+
+// prints the report when the program ends
+struct Reporter {
+    ~Reporter() {
+        threadTable.flush();
+        std::lock_guard<std::mutex> guard(globalLock);
+
+        // sort the used slots by number of allocations, biggest first (simple
+        // selection of the top 15, the table is small)
+        std::fprintf(stderr, "\n===== allocation report =====\n");
+        std::fprintf(stderr, "allocations: %llu, frees: %llu, still live at exit: %lld bytes, peak live: %lld bytes\n",
+                     (unsigned long long)totalAllocations.load(), (unsigned long long)totalFrees.load(),
+                     (long long)liveBytes.load(), (long long)peakBytes.load());
+        bool shown[kSites] = {};
+        for (int rank = 0; rank < 15; rank++) {
+            size_t best = kSites;
+            for (size_t i = 0; i < kSites; i++) {
+                const SiteStats& s = globalTable.slots[i];
+                if (s.site == nullptr || shown[i]) continue;
+                if (best == kSites || s.allocations > globalTable.slots[best].allocations) best = i;
+            }
+            if (best == kSites) break;
+            shown[best] = true;
+            const SiteStats& s = globalTable.slots[best];
+            std::fprintf(stderr, "#%d  %llu allocations, %llu frees, %llu bytes (sizes %llu..%llu)\n", rank + 1,
+                         (unsigned long long)s.allocations, (unsigned long long)s.frees,
+                         (unsigned long long)s.bytes, (unsigned long long)s.smallest,
+                         (unsigned long long)s.largest);
+            printSite(s.site);
+        }
+        std::fprintf(stderr, "A site with several allocations of growing sizes (like 4, 8, 16 ...) is a\n"
+                             "container reallocating: each of those is one grow step.\n");
+    }
+};
+Reporter reporter; // constructed before main, destroyed (= report printed) after main
+
+} // namespace
+
+// the replaced global operators; the call site is found from the return address
+void* operator new(size_t size) {
+    void* p = trackedAlloc(size, callSite(__builtin_return_address(0)));
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) {
+    void* p = trackedAlloc(size, callSite(__builtin_return_address(0)));
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size, callSite(__builtin_return_address(0)));
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size, callSite(__builtin_return_address(0)));
+}
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { trackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+
+#ifdef ALLOCATION_TRACKER_DEMO
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+using namespace std;
+
+class Student {
+public:
+    int roll;
+    string name;
+    Student(int r, string n) : roll(r), name(n) {}
+};
+
+int main() {
+    vector<char> v;
+    for (int i = 0; i < 1000; i++) v.push_back('a' + i % 26); // about 11 reallocations
+    cout << "size " << v.size() << ", capacity " << v.capacity() << endl;
+
+    Student s1(10, "A name that is too long for the small string buffer");
+    vector<Student> copies(100, s1); // 100 copies, each copies the name
+    thread worker([]() {
+        vector<int> w;
+        for (int i = 0; i < 100000; i++) w.push_back(i);
+    });
+    worker.join();
+    cout << "copies: " << copies.size() << endl;
+    return 0;
+}
+#endif
@@ -0,0 +1,300 @@
+/*
+A vector where WE choose how it grows and shrinks.
+
+"size and capacity of vector checking .cpp" shows that std::vector doubles its
+capacity and keeps the capacity after clear(). Here both are settings:
+
+    growthFactor :- new capacity = old capacity * growthFactor (2.0 like libstdc++,
+                    1.5 like MSVC, or anything else)
+    shrinkPolicy :- Never          -> clear()/pop_back() keep the memory (std::vector)
+                    OnClear        -> clear() gives the memory back
+                    QuarterFull    -> when size drops below capacity / 4, the
+                                      capacity is halved
+
+Growing without copying :- std::vector always allocates a NEW block, copies (or
+moves) every element and frees the old block. For element types that can be
+moved with memcpy (int, char, double, plain structs) we can do better:
+    small blocks -> realloc()  : often just extends the block where it is
+    big blocks   -> mremap()   : (Linux) the kernel moves the page table entries,
+                                 the bytes themselves are never copied
+Types like string still go the normal way (allocate, move each element, free).
+
+Statistics (reallocations, how many grew in place, elements copied by us) are
+printed by printVectorInfo() in the same way as in the lecture file.
+
+compile :- g++ -std=c++17 -O2 "growth policy vector .cpp"
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+enum class ShrinkPolicy { Never, OnClear, QuarterFull };
+
+struct GrowthStats {
+    size_t reallocations = 0;    // how many times the capacity changed
+    size_t inPlace = 0;          // ... of those, how many kept the same address
+    size_t remaps = 0;           // ... of those, how many used mremap
+    size_t elementsCopied = 0;   // elements copied/moved one by one by us
+};
+
+template <class T>
+class GrowVector {
+    // memcpy is a valid way to move these, so realloc/mremap can be used
+    static constexpr bool kRelocatable = is_trivially_copyable<T>::value;
+    // blocks at least this big are mmap'ed so that mremap can grow them
+    static constexpr size_t kMapBytes = 1 << 20;
+
+public:
+    GrowVector(double growthFactor = 2.0, ShrinkPolicy shrink = ShrinkPolicy::Never)
+        : factor(growthFactor < 1.1 ? 1.1 : growthFactor), policy(shrink) {}
+
+    GrowVector(initializer_list<T> init, double growthFactor = 2.0,
+               ShrinkPolicy shrink = ShrinkPolicy::Never)
+        : GrowVector(growthFactor, shrink) {
+        reserve(init.size());
+        for (const T& x : init) push_back(x);
+    }
+
+    GrowVector(const GrowVector&) = delete;
+    GrowVector& operator=(const GrowVector&) = delete;
+
+    ~GrowVector() {
+        clearElements();
+        release();
+    }
+
+    void push_back(const T& x) {
+        if (sz == cap) grow();
+        new (data + sz) T(x);
+        sz++;
+    }
+    void push_back(T&& x) {
+        if (sz == cap) grow();
+        new (data + sz) T(move(x));
+        sz++;
+    }
+
+    void pop_back() {
+        data[--sz].~T();
+        if (policy == ShrinkPolicy::QuarterFull && cap > 16 && sz < cap / 4) changeCapacity(cap / 2);
+    }
+
+    void clear() {
+        clearElements();
+        if (policy != ShrinkPolicy::Never && cap > 0) {
+            release();
+            stats.reallocations++;
+        }
+    }
+
+    void reserve(size_t n) {
+        if (n > cap) changeCapacity(n);
+    }
+
+    void shrink_to_fit() {
+        if (cap > sz) changeCapacity(sz);
+    }
+
+    T& operator[](size_t i) { return data[i]; }
+    const T& operator[](size_t i) const { return data[i]; }
+    T* begin() { return data; }
+    T* end() { return data + sz; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + sz; }
+    size_t size() const { return sz; }
+    size_t capacity() const { return cap; }
+    bool empty() const { return sz == 0; }
+    const GrowthStats& statistics() const { return stats; }
+
+private:
+    T* data = nullptr;
+    size_t sz = 0, cap = 0;
+    bool mapped = false;     // true when data came from mmap
+    size_t mappedBytes = 0;
+    double factor;
+    ShrinkPolicy policy;
+    GrowthStats stats;
+
+    void grow() {
+        size_t next = (size_t)(cap * factor);
+        if (next <= cap) next = cap + 1;
+        changeCapacity(next);
+    }
+
+    void clearElements() {
+        for (size_t i = 0; i < sz; i++) data[i].~T();
+        sz = 0;
+    }
+
+    void release() {
+        if (data == nullptr) return;
+        if (mapped) {
+#ifdef __linux__
+            munmap(data, mappedBytes);
+#endif
+        } else if (kRelocatable) {
+            free(data);
+        } else {
+            ::operator delete(data);
+        }
+        data = nullptr;
+        cap = 0;
+        mapped = false;
+    }
+
+    void changeCapacity(size_t newCap) {
+        if (newCap == 0) {
+            release();
+            stats.reallocations++;
+            return;
+        }
+        T* old = data;
+        if constexpr (kRelocatable) {
+            relocate(newCap);
+        } else {
+            T* fresh = static_cast<T*>(::operator new(newCap * sizeof(T)));
+            for (size_t i = 0; i < sz; i++) {
+                new (fresh + i) T(move(data[i]));
+                data[i].~T();
+            }
+            stats.elementsCopied += sz;
+            ::operator delete(data);
+            data = fresh;
+        }
+        cap = newCap;
+        stats.reallocations++;
+        if (old != nullptr && old == data) stats.inPlace++;
+    }
+
+    // memcpy-able types: realloc for small blocks, mmap/mremap for big ones
+    void relocate(size_t newCap) {
+        size_t bytes = newCap * sizeof(T);
+#ifdef __linux__
+        static const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        if (bytes >= kMapBytes) {
+            size_t rounded = (bytes + page - 1) / page * page;
+            void* p;
+            if (mapped) {
+                p = mremap(data, mappedBytes, rounded, MREMAP_MAYMOVE);
+                stats.remaps++;
+            } else {
+                p = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p != MAP_FAILED && sz > 0) {
+                    memcpy(p, data, sz * sizeof(T));
+                    stats.elementsCopied += sz;
+                }
+                if (p != MAP_FAILED) free(data);
+            }
+            if (p == MAP_FAILED) throw bad_alloc();
+            data = static_cast<T*>(p);
+            mapped = true;
+            mappedBytes = rounded;
+            return;
+        }
+        if (mapped) { // shrinking from a mapping back to a small block
+            void* p = malloc(bytes);
+            if (p == nullptr) throw bad_alloc();
+            memcpy(p, data, min(sz, newCap) * sizeof(T));
+            stats.elementsCopied += min(sz, newCap);
+            munmap(data, mappedBytes);
+            data = static_cast<T*>(p);
+            mapped = false;
+            return;
+        }
+#endif
+        void* p = realloc(data, bytes);
+        if (p == nullptr) throw bad_alloc();
+        data = static_cast<T*>(p);
+    }
+};
+
+const char* policyName(ShrinkPolicy p) {
+    if (p == ShrinkPolicy::OnClear) return "OnClear";
+    if (p == ShrinkPolicy::QuarterFull) return "QuarterFull";
+    return "Never";
+}
+
+// same output as the lecture file, plus the growth statistics
+template <class T>
+void printVectorInfo(const GrowVector<T>& v) {
+    cout << "Vector elements: ";
+    for (const T& ch : v) cout << ch << " ";
+    cout << endl;
+    cout << "Size of vector: " << v.size() << endl;
+    cout << "Capacity of vector: " << v.capacity() << endl;
+    const GrowthStats& s = v.statistics();
+    cout << "Reallocations: " << s.reallocations << " (in place: " << s.inPlace
+         << ", mremap: " << s.remaps << ", elements copied: " << s.elementsCopied << ")" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    // same steps as "size and capacity of vector checking .cpp", but clear() frees memory
+    GrowVector<char> v({'a', 'b', 'c', 'd', 'e'}, 1.5, ShrinkPolicy::OnClear);
+    cout << "Initial vector state (factor 1.5, shrink " << policyName(ShrinkPolicy::OnClear) << "):\n";
+    printVectorInfo(v);
+    v.push_back('f');
+    cout << "\nAfter push_back('f'):\n";
+    printVectorInfo(v);
+    v.pop_back();
+    cout << "\nAfter pop_back():\n";
+    printVectorInfo(v);
+    v.clear();
+    cout << "\nAfter clear():\n";
+    printVectorInfo(v);
+
+    // strings cannot be memcpy'd, so they take the normal move path
+    GrowVector<string> names(2.0);
+    for (const char* s : {"Bob", "Alice", "Ichigo", "Rukia", "Renji"}) names.push_back(s);
+    cout << "\nstring vector:\n";
+    printVectorInfo(names);
+
+    // benchmark :- push_back n ints one by one
+    size_t n = argc > 1 ? stoul(argv[1]) : 100000000;
+    cout << "\npush_back " << n << " ints:\n";
+
+    auto t0 = chrono::steady_clock::now();
+    {
+        vector<int> sv;
+        for (size_t i = 0; i < n; i++) sv.push_back((int)i);
+        if (sv[n / 2] != (int)(n / 2)) cout << "wrong\n";
+    }
+    auto t1 = chrono::steady_clock::now();
+    cout << "std::vector               : " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+
+    for (double f : {2.0, 1.5}) {
+        auto a = chrono::steady_clock::now();
+        GrowVector<int> gv(f);
+        for (size_t i = 0; i < n; i++) gv.push_back((int)i);
+        auto b = chrono::steady_clock::now();
+        const GrowthStats& s = gv.statistics();
+        cout << "GrowVector factor " << f << "\t   : "
+             << chrono::duration<double, milli>(b - a).count() << " ms, "
+             << s.reallocations << " reallocations, " << s.inPlace << " in place, "
+             << s.remaps << " mremap, " << s.elementsCopied << " elements copied by us\n";
+    }
+    return 0;
+}
+/*
+Why mremap is cheap :- a big block of memory is a list of pages. To make it
+bigger the kernel can give the same physical pages a new (larger) range of
+addresses and add fresh pages at the end. That is work per PAGE TABLE ENTRY,
+not per byte, and no byte of our data is read or written.
+
+Growth factor trade-off :-
+| factor | reallocations for n pushes | unused memory at worst |
+| ------ | -------------------------- | ---------------------- |
+| 2.0    | log2(n)                    | up to 50%              |
+| 1.5    | log1.5(n) (about 1.7x more)| up to 33%              |
+*/
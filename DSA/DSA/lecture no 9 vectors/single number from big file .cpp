@@ -0,0 +1,201 @@
+/*
+singleNumber for data that does not fit in a vector :- a binary file of int32 or
+int64 values (for example IDs from two systems that should match in pairs).
+
+"single number problem .cpp" XORs one int at a time from a vector. For a file of
+10+ GB we want to go as fast as the disk / page cache can give us the bytes:
+
+1. mmap :- the file is mapped into memory, so there is no read() copy into our
+   own buffer. The OS pages it in while we walk forward (MADV_SEQUENTIAL tells it
+   to read ahead).
+2. Wide XOR :- XOR works bit by bit, so the order and grouping of values does not
+   matter. We XOR 32 bytes at a time with AVX2 (or 8 bytes at a time with
+   uint64_t) and fold the wide result down to one int32 / int64 at the end:
+       int32 file :- low 32 bits ^ high 32 bits of every 64-bit word
+3. Threads :- every thread XORs its own part of the file into its own partial
+   result, and the partial results are XORed together at the end.
+
+usage :- "single number from big file .exe" <file> <32|64>
+         without arguments a small test file is created and checked.
+compile :- g++ -std=c++17 -O2 -march=native -pthread "single number from big file .cpp"
+*/
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// the original version, kept to check the result
+int singleNumber(const vector<int>& nums) {
+    int result = 0;
+    for (int num : nums) result ^= num;
+    return result;
+}
+
+// XOR of all 64-bit words in [p, p + bytes), bytes must be a multiple of 8
+uint64_t xorWords(const unsigned char* p, size_t bytes) {
+    size_t i = 0;
+    uint64_t acc = 0;
+#ifdef __AVX2__
+    // 4 independent accumulators so the CPU can do 4 XORs per step in parallel
+    __m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+    for (; i + 128 <= bytes; i += 128) {
+        a0 = _mm256_xor_si256(a0, _mm256_loadu_si256((const __m256i*)(p + i)));
+        a1 = _mm256_xor_si256(a1, _mm256_loadu_si256((const __m256i*)(p + i + 32)));
+        a2 = _mm256_xor_si256(a2, _mm256_loadu_si256((const __m256i*)(p + i + 64)));
+        a3 = _mm256_xor_si256(a3, _mm256_loadu_si256((const __m256i*)(p + i + 96)));
+    }
+    __m256i a = _mm256_xor_si256(_mm256_xor_si256(a0, a1), _mm256_xor_si256(a2, a3));
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, a);
+    acc = lanes[0] ^ lanes[1] ^ lanes[2] ^ lanes[3];
+#endif
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t w;
+        memcpy(&w, p + i, 8); // memcpy = safe unaligned load, compiles to one mov
+        acc ^= w;
+    }
+    return acc;
+}
+
+// XOR of bytes / 8 whole words split between threads, plus a last half word
+// when bytes ends in 4 (an int32 file); the caller folds it to the file's width
+uint64_t xorParallel(const unsigned char* data, size_t bytes, unsigned threads) {
+    size_t words = bytes / 8;
+    size_t chunk = ((words + threads - 1) / threads) * 8; // bytes per thread, whole words
+    vector<uint64_t> partial(threads, 0);
+    vector<thread> pool;
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            size_t lo = min(words * 8, t * chunk);
+            size_t hi = min(words * 8, lo + chunk);
+            partial[t] = xorWords(data + lo, hi - lo);
+        });
+    }
+    for (auto& th : pool) th.join();
+    uint64_t result = 0;
+    for (uint64_t x : partial) result ^= x;
+
+    // an int32 file can end with half a word
+    if (bytes % 8 == 4) {
+        uint32_t tail;
+        memcpy(&tail, data + words * 8, 4);
+        result ^= tail;
+    }
+    return result;
+}
+
+int64_t foldResult(uint64_t x, int width) {
+    if (width == 4) return (int32_t)(uint32_t)(x ^ (x >> 32));
+    return (int64_t)x;
+}
+
+// maps the file and XORs it, returns false if the file cannot be read
+bool singleNumberFile(const string& path, int width, unsigned threads, int64_t& answer) {
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) { close(fd); return false; }
+    size_t bytes = st.st_size;
+    if (bytes == 0) { close(fd); answer = 0; return true; }
+    void* map = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps the file alive
+    if (map == MAP_FAILED) return false;
+    madvise(map, bytes, MADV_SEQUENTIAL);
+    answer = foldResult(xorParallel((const unsigned char*)map, bytes - bytes % width, threads), width);
+    munmap(map, bytes);
+    return true;
+#else
+    // no mmap on Windows here: read big blocks and XOR them one after another
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+    vector<unsigned char> block(64 << 20);
+    uint64_t acc = 0;
+    while (in) {
+        in.read((char*)block.data(), block.size());
+        size_t got = in.gcount();
+        acc ^= xorParallel(block.data(), got - got % width, threads);
+    }
+    answer = foldResult(acc, width);
+    return true;
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    unsigned threads = max(1u, thread::hardware_concurrency());
+
+    if (argc >= 3) {
+        int width = stoi(argv[2]) == 64 ? 8 : 4;
+        int64_t answer;
+        auto t0 = chrono::steady_clock::now();
+        if (!singleNumberFile(argv[1], width, threads, answer)) {
+            cout << "cannot read " << argv[1] << endl;
+            return 1;
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        cout << "single number: " << answer << " (" << ms << " ms)" << endl;
+        return 0;
+    }
+
+    // no file given: write pairs of random IDs plus one single ID, shuffled
+    size_t pairs = 25000000; // 50M int32 values = 200 MB
+    mt19937 rng(9);
+    vector<int> nums;
+    nums.reserve(2 * pairs + 1);
+    for (size_t i = 0; i < pairs; i++) {
+        int x = (int)rng();
+        nums.push_back(x);
+        nums.push_back(x);
+    }
+    nums.push_back(123456789);
+    shuffle(nums.begin(), nums.end(), rng);
+
+    string path = "single_number_test.bin";
+    {
+        ofstream out(path, ios::binary);
+        out.write((const char*)nums.data(), nums.size() * sizeof(int));
+    }
+
+    auto t0 = chrono::steady_clock::now();
+    int expected = singleNumber(nums);
+    auto t1 = chrono::steady_clock::now();
+    int64_t answer = 0;
+    bool ok = singleNumberFile(path, 4, threads, answer);
+    auto t2 = chrono::steady_clock::now();
+    remove(path.c_str());
+
+    double mb = nums.size() * sizeof(int) / 1048576.0;
+    double msVec = chrono::duration<double, milli>(t1 - t0).count();
+    double msFile = chrono::duration<double, milli>(t2 - t1).count();
+    cout << "values: " << nums.size() << " (" << mb << " MB), threads: " << threads << "\n";
+    cout << "vector singleNumber : " << expected << " in " << msVec << " ms\n";
+    cout << "mmap + wide XOR     : " << (ok ? answer : -1) << " in " << msFile << " ms ("
+         << mb / (msFile / 1000) << " MB/s, includes mapping the file)\n";
+    cout << (ok && answer == expected ? "results match" : "MISMATCH") << endl;
+    return 0;
+}
+/*
+Why folding works for int32 :- a 64-bit word holds two int32 values, one in the
+low half and one in the high half. XORing many words XORs all low halves together
+and all high halves together. Every value is in one of the two halves, so
+low ^ high is the XOR of every int32 in the file.
+
+Little endian (x86, ARM) is assumed, like the file itself which is just the raw
+bytes of the values.
+*/
@@ -0,0 +1,220 @@
+/*
+Single number, general version :- every element appears exactly k times, except
+one element that appears only once. Find that one.
+
+XOR ("single number problem .cpp") only works for k = 2, because x ^ x = 0 but
+x ^ x ^ x = x. For any k we count, for every one of the 32 bit positions, how many
+numbers have a 1 there, modulo k. Every repeated number adds k (= 0 mod k) to the
+positions where it has a 1, so at the end a position is non-zero exactly where
+the single number has a 1.
+
+Bit-sliced counters :- instead of 32 separate counters we keep the counters
+"sideways". plane[j] is one 32-bit word that holds bit j of all 32 counters.
+Adding a number x (one bit per position) to all 32 counters at once is a ripple
+carry adder made of AND / XOR:
+        carry = x
+        for every plane j:  newCarry = plane[j] & carry
+                            plane[j] = plane[j] ^ carry
+                            carry    = newCarry
+Then the counters that reached k are found with AND of plane bits (compare with
+the bits of k) and cleared. A counter never goes above k, so bitLength(k)
+planes are enough: O(1) memory and O(n * log k) bit operations for any k.
+
+With AVX2 the planes are 256 bits wide: 8 numbers are added per step, each one
+into its own 32-bit lane. At the end the 8 lanes (and the results of the threads)
+are added together modulo k position by position.
+
+compile :- g++ -std=c++17 -O2 -march=native -pthread "single number k times .cpp"
+*/
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// counts[p] = how many numbers have bit p set, modulo k
+struct BitCounts {
+    uint32_t counts[32] = {};
+};
+
+int bitLength(uint32_t k) {
+    int b = 0;
+    while (k >> b) b++;
+    return b;
+}
+
+void addCounts(BitCounts& into, const BitCounts& from, uint32_t k) {
+    for (int p = 0; p < 32; p++) into.counts[p] = (into.counts[p] + from.counts[p]) % k;
+}
+
+// scalar kernel, 32-bit planes
+BitCounts countScalar(const int* a, size_t n, uint32_t k) {
+    int b = bitLength(k);
+    uint32_t plane[32] = {};
+    for (size_t i = 0; i < n; i++) {
+        uint32_t carry = (uint32_t)a[i];
+        for (int j = 0; j < b; j++) {
+            uint32_t next = plane[j] & carry;
+            plane[j] ^= carry;
+            carry = next;
+        }
+        // positions whose counter equals k
+        uint32_t eq = ~0u;
+        for (int j = 0; j < b; j++) eq &= ((k >> j) & 1) ? plane[j] : ~plane[j];
+        for (int j = 0; j < b; j++) plane[j] &= ~eq;
+    }
+    BitCounts r;
+    for (int p = 0; p < 32; p++) {
+        uint32_t c = 0;
+        for (int j = 0; j < b; j++) c |= ((plane[j] >> p) & 1u) << j;
+        r.counts[p] = c;
+    }
+    return r;
+}
+
+#ifdef __AVX2__
+// 8 lanes at a time, 256-bit planes
+BitCounts countAVX2(const int* a, size_t n, uint32_t k) {
+    int b = bitLength(k);
+    __m256i plane[32];
+    for (int j = 0; j < b; j++) plane[j] = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi32(-1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i carry = _mm256_loadu_si256((const __m256i*)(a + i));
+        for (int j = 0; j < b; j++) {
+            __m256i next = _mm256_and_si256(plane[j], carry);
+            plane[j] = _mm256_xor_si256(plane[j], carry);
+            carry = next;
+        }
+        __m256i eq = ones;
+        for (int j = 0; j < b; j++) {
+            eq = ((k >> j) & 1) ? _mm256_and_si256(eq, plane[j]) : _mm256_andnot_si256(plane[j], eq);
+        }
+        for (int j = 0; j < b; j++) plane[j] = _mm256_andnot_si256(eq, plane[j]);
+    }
+    // add the 8 lanes together
+    BitCounts r;
+    for (int j = 0; j < b; j++) {
+        uint32_t lanes[8];
+        _mm256_storeu_si256((__m256i*)lanes, plane[j]);
+        for (int l = 0; l < 8; l++) {
+            for (int p = 0; p < 32; p++) r.counts[p] += ((lanes[l] >> p) & 1u) << j;
+        }
+    }
+    for (int p = 0; p < 32; p++) r.counts[p] %= k;
+    addCounts(r, countScalar(a + i, n - i, k), k); // the last n % 8 numbers
+    return r;
+}
+#endif
+
+BitCounts countBlock(const int* a, size_t n, uint32_t k) {
+#ifdef __AVX2__
+    return countAVX2(a, n, k);
+#else
+    return countScalar(a, n, k);
+#endif
+}
+
+int fromCounts(const BitCounts& c) {
+    uint32_t x = 0;
+    for (int p = 0; p < 32; p++) if (c.counts[p] != 0) x |= 1u << p;
+    return (int)x;
+}
+
+// k < 2 has no meaning here: with k = 1 every counter is always 0 (mod 1)
+// and k = 0 divides by zero, so it is refused before any work is split
+int singleNumberK(const vector<int>& nums, uint32_t k, unsigned threads = 1) {
+    if (k < 2) throw invalid_argument("singleNumberK: k must be at least 2, got " + to_string(k));
+    threads = max(1u, threads);
+    size_t n = nums.size();
+    vector<BitCounts> partial(threads);
+    vector<thread> pool;
+    size_t chunk = (n + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            size_t lo = min(n, t * chunk), hi = min(n, lo + chunk);
+            partial[t] = countBlock(nums.data() + lo, hi - lo, k);
+        });
+    }
+    for (auto& th : pool) th.join();
+    BitCounts total;
+    for (auto& p : partial) addCounts(total, p, k);
+    return fromCounts(total);
+}
+
+// baseline: count every value in a hash map
+int singleNumberHash(const vector<int>& nums, uint32_t k) {
+    unordered_map<int, uint32_t> count;
+    count.reserve(nums.size() / k + 1);
+    for (int x : nums) count[x]++;
+    for (auto& kv : count) if (kv.second % k != 0) return kv.first;
+    return 0;
+}
+
+vector<int> makeInput(size_t groups, uint32_t k, int single, mt19937& rng) {
+    vector<int> v;
+    v.reserve(groups * k + 1);
+    for (size_t g = 0; g < groups; g++) {
+        int x = (int)rng();
+        if (x == single) x++;
+        for (uint32_t c = 0; c < k; c++) v.push_back(x);
+    }
+    v.push_back(single);
+    shuffle(v.begin(), v.end(), rng);
+    return v;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> nums1 = {2, 2, 3, 2};
+    cout << "k = 3, {2, 2, 3, 2}            : " << singleNumberK(nums1, 3) << endl;
+    vector<int> nums2 = {0, 1, 0, 1, 0, 1, 99};
+    cout << "k = 3, {0, 1, 0, 1, 0, 1, 99}  : " << singleNumberK(nums2, 3) << endl;
+    vector<int> nums3 = {-5, 7, 7, 7, 7, 7};
+    cout << "k = 5, {-5, 7, 7, 7, 7, 7}     : " << singleNumberK(nums3, 5) << endl;
+    try {
+        singleNumberK(nums1, 1);
+    } catch (const invalid_argument& e) {
+        cout << "k = 1                          : " << e.what() << "\n\n";
+    }
+
+    size_t n = argc > 1 ? stoul(argv[1]) : 30000000;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    mt19937 rng(21);
+    for (uint32_t k : {2u, 3u, 5u, 7u, 16u}) {
+        vector<int> v = makeInput(n / k, k, -424242, rng);
+        auto t0 = chrono::steady_clock::now();
+        int a = singleNumberK(v, k, 1);
+        auto t1 = chrono::steady_clock::now();
+        int b = singleNumberK(v, k, threads);
+        auto t2 = chrono::steady_clock::now();
+        int c = singleNumberHash(v, k);
+        auto t3 = chrono::steady_clock::now();
+        cout << "k = " << k << " (" << v.size() << " values)  bit-sliced: "
+             << chrono::duration<double, milli>(t1 - t0).count() << " ms, "
+             << threads << " threads: " << chrono::duration<double, milli>(t2 - t1).count()
+             << " ms, hash map: " << chrono::duration<double, milli>(t3 - t2).count() << " ms"
+             << (a == -424242 && b == a && c == a ? "" : "  MISMATCH") << endl;
+    }
+    return 0;
+}
+/*
+Example for k = 3 (2 planes, counter goes 0 -> 1 -> 2 -> back to 0):
+  counter value | plane[1] bit | plane[0] bit
+        0       |      0       |      0
+        1       |      0       |      1
+        2       |      1       |      0
+        3       |      1       |      1   <- equals k, cleared to 0 right away
+
+The hash map needs memory for every distinct value and a random memory access
+per value; the bit-sliced counters need b words and only a few AND / XOR per value.
+*/
@@ -0,0 +1,243 @@
+/*
+Small vector :- a vector that keeps its first N elements INSIDE the object itself.
+
+In "size and capacity of vector checking .cpp" and "using fo foreach loop in
+vector .cpp" the vectors hold only 5 or 6 chars, but std::vector still asks the
+heap for memory (new) and gives it back (delete) every time one is created.
+When millions of short vectors are made and thrown away, those heap calls cost
+more than the work on the chars.
+
+SmallVector<T, N> has a buffer for N elements inside the object:
+    size <= N  -> elements live in the buffer, no heap at all
+    size >  N  -> it "spills": moves everything to a heap block and from then on
+                  grows like std::vector (doubling)
+
+It has the operations used in the lecture files: initializer list, push_back,
+pop_back, clear, size, capacity, [] and range-based for, so
+printVectorInfo() works on it without changes.
+
+compile :- g++ -std=c++17 -O2 "small vector .cpp"
+*/
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <new>
+#include <utility>
+#include <initializer_list>
+using namespace std;
+
+// Both containers below get their heap blocks from this allocator, so the
+// counter sees exactly the blocks of the vectors (and not the ones cout or
+// the rest of the program asks for).
+static size_t heapAllocations = 0;
+
+template <class T>
+struct CountingAllocator {
+    using value_type = T;
+    CountingAllocator() = default;
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        heapAllocations++;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) noexcept { ::operator delete(p); }
+};
+template <class T, class U>
+bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) { return true; }
+template <class T, class U>
+bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) { return false; }
+
+// std::vector<char>, only with the counting allocator
+using CountedVector = vector<char, CountingAllocator<char>>;
+
+template <class T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs room for at least 1 element inside (use std::vector for N = 0)");
+
+public:
+    SmallVector() = default;
+
+    SmallVector(initializer_list<T> init) {
+        reserve(init.size());
+        for (const T& x : init) push_back(x);
+    }
+
+    SmallVector(const SmallVector& other) {
+        reserve(other.sz);
+        for (const T& x : other) push_back(x);
+    }
+
+    SmallVector(SmallVector&& other) noexcept {
+        if (other.onHeap()) { // just take the heap block
+            data = other.data;
+            cap = other.cap;
+            sz = other.sz;
+            other.data = other.inlineData();
+            other.cap = N;
+            other.sz = 0;
+        } else {
+            for (T& x : other) push_back(move(x));
+            other.clear();
+        }
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.sz);
+            for (const T& x : other) push_back(x);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this == &other) return *this;
+        clear();
+        if (other.onHeap()) {
+            if (onHeap()) CountingAllocator<T>().deallocate(data, cap);
+            data = other.data;
+            cap = other.cap;
+            sz = other.sz;
+            other.data = other.inlineData();
+            other.cap = N;
+            other.sz = 0;
+        } else {
+            for (T& x : other) push_back(move(x));
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        if (onHeap()) CountingAllocator<T>().deallocate(data, cap);
+    }
+
+    void push_back(const T& x) {
+        if (sz == cap) reserve(cap * 2);
+        new (data + sz) T(x);
+        sz++;
+    }
+    void push_back(T&& x) {
+        if (sz == cap) reserve(cap * 2);
+        new (data + sz) T(move(x));
+        sz++;
+    }
+
+    void pop_back() { data[--sz].~T(); }
+
+    // like std::vector, clear keeps the capacity
+    void clear() {
+        for (size_t i = 0; i < sz; i++) data[i].~T();
+        sz = 0;
+    }
+
+    void reserve(size_t n) {
+        if (n <= cap) return;
+        T* fresh = CountingAllocator<T>().allocate(n);
+        for (size_t i = 0; i < sz; i++) {
+            new (fresh + i) T(move(data[i]));
+            data[i].~T();
+        }
+        if (onHeap()) CountingAllocator<T>().deallocate(data, cap);
+        data = fresh;
+        cap = n;
+    }
+
+    T& operator[](size_t i) { return data[i]; }
+    const T& operator[](size_t i) const { return data[i]; }
+    T* begin() { return data; }
+    T* end() { return data + sz; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + sz; }
+    size_t size() const { return sz; }
+    size_t capacity() const { return cap; }
+    bool empty() const { return sz == 0; }
+    bool isInline() const { return !onHeap(); }
+
+private:
+    alignas(T) unsigned char buffer[N * sizeof(T)];
+    T* data = inlineData();
+    size_t sz = 0;
+    size_t cap = N;
+
+    T* inlineData() { return reinterpret_cast<T*>(buffer); }
+    bool onHeap() const { return data != reinterpret_cast<const T*>(buffer); }
+};
+
+// the function from "size and capacity of vector checking .cpp", made generic
+template <class Vec>
+void printVectorInfo(const Vec& v) {
+    cout << "Vector elements: ";
+    for (char ch : v) cout << ch << " ";
+    cout << endl;
+    cout << "Size of vector: " << v.size() << endl;
+    cout << "Capacity of vector: " << v.capacity() << endl;
+}
+
+// build a short sequence, use it, throw it away
+template <class Vec>
+long long churn(size_t rounds) {
+    long long checksum = 0;
+    for (size_t r = 0; r < rounds; r++) {
+        Vec v;
+        size_t len = 3 + r % 6;            // 3 .. 8 chars
+        for (size_t i = 0; i < len; i++) v.push_back((char)('a' + (r + i) % 26));
+        for (char ch : v) checksum += ch;
+    }
+    return checksum;
+}
+
+int main(int argc, char* argv[]) {
+    size_t before = heapAllocations;
+    SmallVector<char, 8> v = {'a', 'b', 'c', 'd', 'e'};
+    cout << "Initial vector state:\n";
+    printVectorInfo(v);
+    v.push_back('f');
+    cout << "\nAfter push_back('f'):\n";
+    printVectorInfo(v);
+    v.pop_back();
+    cout << "\nAfter pop_back():\n";
+    printVectorInfo(v);
+    cout << "\nIterating through vector: \n";
+    for (char num : v) cout << num << " \n";
+    cout << "heap allocations so far: " << heapAllocations - before << " (inline: " << v.isInline() << ")\n";
+
+    for (char ch = 'g'; ch <= 'k'; ch++) v.push_back(ch); // 10 chars > 8 -> spills
+    cout << "\nAfter 5 more push_back (spilled to heap):\n";
+    printVectorInfo(v);
+    cout << "heap allocations so far: " << heapAllocations - before << " (inline: " << v.isInline() << ")\n\n";
+
+    // benchmark :- millions of short vectors created and destroyed
+    size_t rounds = argc > 1 ? stoul(argv[1]) : 10000000;
+    size_t a0 = heapAllocations;
+    auto t0 = chrono::steady_clock::now();
+    long long c1 = churn<CountedVector>(rounds);
+    auto t1 = chrono::steady_clock::now();
+    size_t a1 = heapAllocations;
+    long long c2 = churn<SmallVector<char, 16>>(rounds);
+    auto t2 = chrono::steady_clock::now();
+    size_t a2 = heapAllocations;
+
+    double ms1 = chrono::duration<double, milli>(t1 - t0).count();
+    double ms2 = chrono::duration<double, milli>(t2 - t1).count();
+    cout << rounds << " short sequences (3..8 chars):\n";
+    cout << "vector<char>          : " << ms1 << " ms, " << a1 - a0 << " heap allocations, "
+         << ms1 * 1e6 / rounds << " ns each\n";
+    cout << "SmallVector<char, 16> : " << ms2 << " ms, " << a2 - a1 << " heap allocations, "
+         << ms2 * 1e6 / rounds << " ns each\n";
+    cout << (c1 == c2 ? "same checksum" : "MISMATCH") << endl;
+    return 0;
+}
+/*
+Why vector<char> needs several allocations per sequence :- it starts with
+capacity 0 and doubles: 1, 2, 4, 8. Each step is a new heap block, so 8 chars
+cost 4 allocations and 4 frees. SmallVector<char, 16> never touches the heap for
+these lengths.
+
+The cost :- the object is bigger (16 chars of buffer always present) and moving a
+SmallVector that is still inline copies its elements instead of just taking a
+pointer. Choose N about as big as the usual length, not the biggest one.
+*/